@@ -0,0 +1,103 @@
+#include "Benchmark.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+
+static std::atomic<uint64_t> allocations(0);
+
+uint64_t AllocationCount()
+{
+	return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = std::malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+// a measured run should last at least this long
+const double MIN_RUN_SECONDS = 0.25;
+
+BenchmarkRunner::BenchmarkRunner(const std::string& filter)
+	: Failures(0), filter(filter)
+{
+	std::printf("%-56s %14s %12s %12s\n", "benchmark", "iterations", "ns/op", "allocs/op");
+}
+
+void BenchmarkRunner::Section(const std::string& title)
+{
+	pendingSection = title;
+}
+
+bool BenchmarkRunner::Check(bool passed, const std::string& what)
+{
+	if (!passed)
+	{
+		std::printf("FAILED: %s\n", what.c_str());
+		++Failures;
+	}
+	return passed;
+}
+
+void BenchmarkRunner::Run(const std::string& name, const Body& body)
+{
+	if (!filter.empty() && name.find(filter) == std::string::npos)
+		return;
+	if (!pendingSection.empty())
+	{
+		std::printf("-- %s\n", pendingSection.c_str());
+		pendingSection.clear();
+	}
+
+	typedef std::chrono::steady_clock Clock;
+	uint64_t iterations = 1;
+	while (true)
+	{
+		uint64_t allocationsBefore = AllocationCount();
+		Clock::time_point start = Clock::now();
+		body(iterations);
+		double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		uint64_t allocated = AllocationCount() - allocationsBefore;
+
+		if (seconds >= MIN_RUN_SECONDS || iterations >= (1ull << 40))
+		{
+			std::printf("%-56s %14llu %12.1f %12.2f\n", name.c_str(), (unsigned long long)iterations,
+				seconds * 1e9 / iterations, static_cast<double>(allocated) / iterations);
+			return;
+		}
+		// aim a little past the minimum so the next run is usually the measured one
+		double scale = seconds > 0.0 ? MIN_RUN_SECONDS * 1.2 / seconds : 100.0;
+		iterations = static_cast<uint64_t>(iterations * std::min(100.0, std::max(2.0, scale)));
+	}
+}
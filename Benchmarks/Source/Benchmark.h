@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <functional>
+
+// heap allocations made by this process so far (global operator new is counted)
+uint64_t AllocationCount();
+
+// keeps the compiler from optimizing away a result the benchmark does not otherwise use
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	// an empty asm the compiler has to assume reads value through its address
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	const volatile char* bytes = reinterpret_cast<const volatile char*>(&value);
+	(void)*bytes;
+#endif
+}
+
+// Times small pieces of code. Each benchmark body runs `iterations` operations; the runner grows
+// the iteration count until a run is long enough to time reliably, then reports ns and heap
+// allocations per operation.
+class BenchmarkRunner
+{
+public:
+	typedef std::function<void(uint64_t iterations)> Body;
+
+	// only benchmarks whose name contains filter are run
+	explicit BenchmarkRunner(const std::string& filter = "");
+
+	void Run(const std::string& name, const Body& body);
+
+	// prints a section title when at least one of its benchmarks passes the filter
+	void Section(const std::string& title);
+
+	// a correctness check the numbers depend on; a failed one prints FAILED and counts towards Failures,
+	// which makes the run exit nonzero
+	bool Check(bool passed, const std::string& what);
+	unsigned int Failures;
+private:
+	std::string filter;
+	std::string pendingSection;
+};
@@ -0,0 +1,29 @@
+#include "Benchmark.h"
+#include <iostream>
+
+void RunSimBenchmarks(BenchmarkRunner& runner, const std::string& root);
+void RunRenderBenchmarks(BenchmarkRunner& runner, const std::string& root);
+
+// Microbenchmarks for the game's hot paths.
+// usage: Benchmarks [--filter <substring>] [--root <Breakout2.0 project dir>]
+// exits nonzero when one of the correctness checks printed along the way failed
+int main(int argc, char* argv[])
+{
+	std::string filter;
+	std::string root = "../Breakout2.0/";
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--filter" && i + 1 < argc)
+			filter = argv[++i];
+		else if (arg == "--root" && i + 1 < argc)
+			root = std::string(argv[++i]) + "/";
+	}
+
+	BenchmarkRunner runner(filter);
+	RunSimBenchmarks(runner, root);
+	RunRenderBenchmarks(runner, root);
+	if (runner.Failures)
+		std::cout << runner.Failures << " checks FAILED" << std::endl;
+	return runner.Failures ? 1 : 0;
+}
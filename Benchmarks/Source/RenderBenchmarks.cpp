@@ -0,0 +1,507 @@
+#include "pch.h"
+#include "Benchmark.h"
+#include "ResourceManager.h"
+#include "ParticleSystem/ParticleSystem.h"
+#include "SpriteRenderer.h"
+#include "SpriteBatch.h"
+#include "BrickRenderer.h"
+#include "FrameData.h"
+#include "GLState.h"
+#include "PostProcessing/Bloom.h"
+#include <GameLevel.h>
+#include <Random.h>
+
+const unsigned int SCENE_WIDTH = 320, SCENE_HEIGHT = 240;
+
+// the renderer side classes create GL objects when constructed, so they need a (hidden) context
+static GLFWwindow* createHiddenContext()
+{
+	if (!glfwInit())
+		return nullptr;
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(64, 64, "Benchmarks", nullptr, nullptr);
+	if (!window)
+		return nullptr;
+	glfwMakeContextCurrent(window);
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+	{
+		glfwDestroyWindow(window);
+		return nullptr;
+	}
+	return window;
+}
+
+// a level's worth of sprites: background, bricks grouped by texture like Game::Render, paddle, a rotated power-up and the ball
+template<typename Renderer>
+static void drawScene(Renderer& renderer, const Texture2D* textures)
+{
+	renderer.DrawSprite(textures[0], glm::vec2(0.0f), glm::vec2(SCENE_WIDTH, SCENE_HEIGHT));
+	for (int solid = 1; solid >= 0; --solid)
+	{
+		for (unsigned int y = 0; y < 8; ++y)
+			for (unsigned int x = 0; x < 15; ++x)
+				if (((x + y) % 3 == 0) == (solid != 0))
+					renderer.DrawSprite(textures[1 + solid], glm::vec2(x * 21.0f, y * 10.0f), glm::vec2(21.0f, 10.0f), 0.0f, glm::vec3(0.2f + x / 20.0f, 0.6f, 1.0f - y / 10.0f));
+	}
+	renderer.DrawSprite(textures[3], glm::vec2(130.0f, 220.0f), glm::vec2(60.0f, 12.0f));
+	renderer.DrawSprite(textures[1], glm::vec2(90.0f, 150.0f), glm::vec2(40.0f, 10.0f), 30.0f, glm::vec3(1.0f, 0.5f, 0.5f));
+	renderer.DrawSprite(textures[3], glm::vec2(200.0f, 120.0f), glm::vec2(12.0f, 12.0f));
+}
+
+// the level's bricks one sprite each, grouped by texture
+static void drawBricks(SpriteBatch& batch, const GameLevel& level, const Texture2D* textures)
+{
+	batch.Begin();
+	for (int solid = 1; solid >= 0; --solid)
+	{
+		for (unsigned int i = 0; i < level.Bricks.size(); ++i)
+		{
+			const GameObject& brick = level.Bricks[i];
+			if (brick.IsSolid == (solid != 0) && !level.IsDestroyed(i))
+				batch.DrawSprite(textures[1 + solid], brick.Position, brick.Size, 0.0f, brick.Color);
+		}
+	}
+	batch.End();
+}
+
+static std::vector<unsigned char> readScene()
+{
+	std::vector<unsigned char> pixels(SCENE_WIDTH * SCENE_HEIGHT * 4);
+	glReadPixels(0, 0, SCENE_WIDTH, SCENE_HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	return pixels;
+}
+
+static int maxDifference(const std::vector<unsigned char>& expected, const std::vector<unsigned char>& actual)
+{
+	int difference = 0;
+	for (size_t i = 0; i < expected.size(); ++i)
+		difference = std::max(difference, std::abs(expected[i] - actual[i]));
+	return difference;
+}
+
+static void runSpriteBenchmarks(BenchmarkRunner& runner, const std::string& root)
+{
+	const std::string shaders = root + "Source/Breakout/Shaders/";
+	Shader& sprite = ResourceManager::GetShader(ResourceManager::LoadShader((shaders + "vsSprite.shader").c_str(), (shaders + "fsSprite.shader").c_str(), nullptr, "sprite"));
+	Shader& batched = ResourceManager::GetShader(ResourceManager::LoadShader((shaders + "vsSpriteBatch.shader").c_str(), (shaders + "fsSpriteBatch.shader").c_str(), nullptr, "spritebatch"));
+	Shader& bricks = ResourceManager::GetShader(ResourceManager::LoadShader((shaders + "vsBrick.shader").c_str(), (shaders + "fsBrick.shader").c_str(), nullptr, "brick"));
+	sprite.Use().SetInteger("image", 0);
+	batched.Use().SetInteger("image", 0);
+	bricks.Use().SetInteger("block", 0);
+	bricks.SetInteger("blockSolid", 1);
+
+	// small procedural textures, enough to tell the sprites apart; 4 texels wide keeps RGB rows 4-byte aligned
+	Texture2D textures[4];
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		unsigned char texels[4 * 4 * 3];
+		for (unsigned int j = 0; j < sizeof(texels); ++j)
+			texels[j] = static_cast<unsigned char>(60 * i + 37 * j);
+		textures[i].Generate(4, 4, texels);
+	}
+
+	SpriteRenderer renderer(sprite);
+	SpriteBatch batch(batched);
+
+	// both paths have to produce the same image
+	glClear(GL_COLOR_BUFFER_BIT);
+	GLState::ResetStats();
+	drawScene(renderer, textures);
+	unsigned int rendererIssued = GLState::Issued, rendererElided = GLState::Elided;
+	std::vector<unsigned char> expected = readScene();
+	glClear(GL_COLOR_BUFFER_BIT);
+	GLState::ResetStats();
+	batch.Begin();
+	drawScene(batch, textures);
+	batch.End();
+	int difference = maxDifference(expected, readScene());
+	std::cout << "-- " << batch.Sprites << " sprites: SpriteRenderer " << batch.Sprites << " draw calls, SpriteBatch "
+		<< batch.DrawCalls << " draw calls, max pixel difference " << difference << std::endl;
+	// the scene switches texture 6 times over its 124 sprites, so that is all the flushes the batch may need
+	runner.Check(difference == 0, "SpriteBatch draws the same pixels as SpriteRenderer");
+	runner.Check(batch.Sprites == 124 && batch.DrawCalls == 6, "SpriteBatch draws the scene's 124 sprites with 6 draw calls");
+	std::cout << "-- GL state calls issued/elided: SpriteRenderer " << rendererIssued << "/" << rendererElided
+		<< ", SpriteBatch " << GLState::Issued << "/" << GLState::Elided << std::endl;
+
+	runner.Run("SpriteRenderer::DrawSprite scene", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			drawScene(renderer, textures);
+			glFinish();
+		}
+	});
+
+	// what setting the sprite's model matrix cost before and after caching the location
+	glm::mat4 model = glm::scale(glm::mat4(1.0f), glm::vec3(21.0f, 10.0f, 1.0f));
+	sprite.Use();
+	runner.Run("glGetUniformLocation + glUniformMatrix4fv", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+			glUniformMatrix4fv(glGetUniformLocation(sprite.ID, "model"), 1, false, glm::value_ptr(model));
+	});
+	Uniform<glm::mat4> modelUniform = sprite.GetUniform<glm::mat4>("model");
+	runner.Run("Shader::Set cached uniform", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+			sprite.Set(modelUniform, model);
+	});
+	runner.Run("SpriteBatch scene", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			batch.Begin();
+			drawScene(batch, textures);
+			batch.End();
+			glFinish();
+		}
+	});
+
+	// a real level, drawn as sprites and instanced; after the first upload only destroyed bricks are patched
+	GameLevel level;
+	level.Load((root + "Source/Breakout/Levels/one.lvl").c_str(), SCENE_WIDTH, SCENE_HEIGHT / 2);
+	BrickRenderer wall(bricks);
+	Pcg32 rng;
+	rng.Seed(42, 0);
+	// two rounds of scattered hits, then a reset standing every brick back up at once
+	for (unsigned int round = 0; round < 3; ++round)
+	{
+		unsigned int destroyed = 0;
+		for (unsigned int i = 0; i < 10 && round < 2; ++i)
+		{
+			unsigned int brick = rng.NextBounded(static_cast<unsigned int>(level.Bricks.size()));
+			if (!level.IsDestroyed(brick))
+			{
+				level.SetDestroyed(brick);
+				++destroyed;
+			}
+		}
+		if (round == 2)
+			level.ResetBricks();
+		glClear(GL_COLOR_BUFFER_BIT);
+		drawBricks(batch, level, textures);
+		std::vector<unsigned char> expected = readScene();
+		glClear(GL_COLOR_BUFFER_BIT);
+		wall.ResetStats();
+		wall.Sync(level);
+		wall.Draw(textures[1], textures[2]);
+		int difference = maxDifference(expected, readScene());
+		std::cout << "-- " << level.Bricks.size() << " bricks, " << (round == 2 ? "reset" : std::to_string(destroyed) + " destroyed")
+			<< ": BrickRenderer uploaded " << wall.Uploads << " instances in " << wall.UploadCalls << " calls, max pixel difference " << difference << std::endl;
+		runner.Check(difference == 0, "BrickRenderer draws the same pixels as SpriteBatch, round " + std::to_string(round));
+		// the first sync uploads the whole layout, scattered hits only themselves, a reset one span
+		if (round == 0)
+			runner.Check(wall.Uploads == level.Bricks.size() && wall.UploadCalls == 1, "BrickRenderer uploads a new layout in one call");
+		else if (round == 1)
+			runner.Check(wall.Uploads == destroyed && wall.UploadCalls <= destroyed, "BrickRenderer patches only the destroyed bricks");
+		else
+			runner.Check(wall.UploadCalls == 1, "BrickRenderer rewrites a reset wall in one call");
+	}
+
+	runner.Run("SpriteBatch level bricks", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			drawBricks(batch, level, textures);
+			glFinish();
+		}
+	});
+	runner.Run("BrickRenderer level bricks", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			wall.Sync(level);
+			wall.Draw(textures[1], textures[2]);
+			glFinish();
+		}
+	});
+}
+
+static std::vector<unsigned char> readTexture(TextureView texture, unsigned int width, unsigned int height)
+{
+	std::vector<unsigned char> pixels(width * height * 4);
+	texture.Bind(0);
+	glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+	return pixels;
+}
+
+static void runPostProcessBenchmarks(BenchmarkRunner& runner, const std::string& root)
+{
+	const std::string shaders = root + "Source/Breakout/Shaders/";
+	auto loadEffect = [&](const char* fragment, const char* name) -> Shader&
+	{
+		return ResourceManager::GetShader(ResourceManager::LoadShader((shaders + "vsEffect.shader").c_str(), (shaders + fragment).c_str(), nullptr, name));
+	};
+	BloomShaders bloom = { &loadEffect("fsBrightPass.shader", "brightpass"), &loadEffect("fsDownsample.shader", "downsample"),
+		&loadEffect("fsBlur.shader", "blur"), &loadEffect("fsBloom.shader", "bloom") };
+	Shader& blur = *bloom.Blur;
+	blur.Use().SetInteger("image", 0);
+
+	// a dim gradient with bright specks, something for the bright pass to find
+	std::vector<unsigned char> texels(SCENE_WIDTH * SCENE_HEIGHT * 3);
+	for (unsigned int y = 0; y < SCENE_HEIGHT; ++y)
+	{
+		for (unsigned int x = 0; x < SCENE_WIDTH; ++x)
+		{
+			unsigned char* texel = &texels[(y * SCENE_WIDTH + x) * 3];
+			bool speck = x % 40 < 4 && y % 30 < 4;
+			texel[0] = speck ? 255 : static_cast<unsigned char>(x / 2);
+			texel[1] = speck ? 255 : static_cast<unsigned char>(y / 2);
+			texel[2] = speck ? 255 : 60;
+		}
+	}
+	Texture2D scene;
+	scene.Generate(SCENE_WIDTH, SCENE_HEIGHT, texels.data());
+
+	// the same blur with a fetch per texel and with texel pairs merged into one filtered fetch
+	RenderTargetPool pool;
+	EffectChain blurChain(pool);
+	blurChain.AddPass(blur, 1.0f, { CHAIN_INPUT }).Direction = glm::vec2(1.0f, 0.0f);
+	blurChain.AddPass(blur, 1.0f, { 0 }).Direction = glm::vec2(0.0f, 1.0f);
+	BlurKernel discrete = GaussianKernel(4.0f, 12, false);
+	BlurKernel linear = GaussianKernel(4.0f, 12, true);
+	SetBlurKernel(blur, discrete);
+	std::vector<unsigned char> expected = readTexture(blurChain.Run(scene, SCENE_WIDTH, SCENE_HEIGHT), SCENE_WIDTH, SCENE_HEIGHT);
+	SetBlurKernel(blur, linear);
+	int difference = maxDifference(expected, readTexture(blurChain.Run(scene, SCENE_WIDTH, SCENE_HEIGHT), SCENE_WIDTH, SCENE_HEIGHT));
+	std::cout << "-- Gaussian blur radius 12: " << 2 * discrete.Taps - 1 << " fetches per direction, " << 2 * linear.Taps - 1
+		<< " with linear sampling, max pixel difference " << difference << std::endl;
+	// filtered fetches land between 8-bit texels, rounding may differ by one
+	runner.Check(difference <= 1, "linear sampled blur matches the per texel one within 1");
+	runner.Check(linear.Taps == 7 && discrete.Taps == 13, "linear sampling halves the blur's fetches");
+
+	SetBlurKernel(blur, discrete);
+	runner.Run("EffectChain separable blur", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			blurChain.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+			glFinish();
+		}
+	});
+	SetBlurKernel(blur, linear);
+	runner.Run("EffectChain separable blur, linear sampling", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			blurChain.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+			glFinish();
+		}
+	});
+
+	// the game's bloom, blurred at quarter resolution, against the same passes all at full resolution
+	EffectChain fullBloom(pool), quarterBloom(pool);
+	AddBloom(fullBloom, bloom, 1.0f);
+	AddBloom(quarterBloom, bloom, 0.25f);
+	fullBloom.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+	quarterBloom.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+	std::cout << "-- bloom: " << fullBloom.PassCount() << " passes writing " << fullBloom.PixelsWritten << " pixels at full resolution, "
+		<< quarterBloom.PassCount() << " passes writing " << quarterBloom.PixelsWritten << " at quarter resolution, "
+		<< pool.Created << " render targets for all chains" << std::endl;
+	// another round has to find every target it needs free in the pool
+	unsigned int created = pool.Created;
+	blurChain.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+	fullBloom.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+	quarterBloom.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+	runner.Check(pool.Created == created, "effect chains reuse their pooled render targets");
+	runner.Check(quarterBloom.PixelsWritten * 2 < fullBloom.PixelsWritten, "quarter resolution bloom writes under half the pixels");
+
+	runner.Run("EffectChain bloom, full resolution", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			fullBloom.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+			glFinish();
+		}
+	});
+	runner.Run("EffectChain bloom, quarter resolution", [&](uint64_t iterations)
+	{
+		for (uint64_t i = 0; i < iterations; ++i)
+		{
+			quarterBloom.Run(scene, SCENE_WIDTH, SCENE_HEIGHT);
+			glFinish();
+		}
+	});
+}
+
+void RunRenderBenchmarks(BenchmarkRunner& runner, const std::string& root)
+{
+	GLFWwindow* window = createHiddenContext();
+	if (!window)
+	{
+		std::cout << "-- no OpenGL context, skipping particle, sprite, post-processing and resource benchmarks" << std::endl;
+		glfwTerminate();
+		return;
+	}
+
+	// everything renders offscreen into a SCENE_WIDTH x SCENE_HEIGHT target
+	unsigned int fbo, color;
+	glGenFramebuffers(1, &fbo);
+	glGenTextures(1, &color);
+	glBindTexture(GL_TEXTURE_2D, color);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, SCENE_WIDTH, SCENE_HEIGHT, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color, 0);
+	glViewport(0, 0, SCENE_WIDTH, SCENE_HEIGHT);
+	glEnable(GL_BLEND);
+	GLState::Invalidate();
+	GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// everything owning GL objects lives in this block, so it is gone before the context is
+	{
+		// the shaders read the projection from the FrameData block
+		FrameUniforms frameUniforms;
+		FrameData frameData = {};
+		frameData.Projection = glm::ortho(0.0f, static_cast<float>(SCENE_WIDTH), static_cast<float>(SCENE_HEIGHT), 0.0f, -1.0f, 1.0f);
+		frameUniforms.Update(frameData);
+
+		runner.Section("particles");
+		const std::string shaders = root + "Source/Breakout/Shaders/";
+		Shader& particleShader = ResourceManager::GetShader(ResourceManager::LoadShader((shaders + "vsParticle.shader").c_str(), (shaders + "fsParticle.shader").c_str(), nullptr, "particle"));
+		particleShader.Use().SetInteger("sprite", 0);
+		Texture2D particleTexture;
+		unsigned char white[4 * 4 * 3];
+		std::fill(white, white + sizeof(white), 255);
+		particleTexture.Generate(4, 4, white);
+
+		const float dt = 1.0f / 60.0f;
+		GameObject emitter(glm::vec2(SCENE_WIDTH / 2.0f, SCENE_HEIGHT / 2.0f), glm::vec2(25.0f), glm::vec3(1.0f), glm::vec2(100.0f, -350.0f));
+		const unsigned int POOL_SIZES[] = { 500, 10000, 1000000 };
+		for (unsigned int size : POOL_SIZES)
+		{
+			ParticleGenerator particles(particleShader, particleTexture, size);
+			particles.Seed(42, 1);
+
+			// particles live for one second, so size * dt new ones per frame keeps the pool just full
+			unsigned int perFrame = std::max(1u, static_cast<unsigned int>(size * dt));
+			for (unsigned int frame = 0; frame < 90; ++frame)
+				particles.Update(dt, emitter, perFrame, glm::vec2(6.25f));
+
+			runner.Run("ParticleGenerator::Update n=" + std::to_string(size) + " steady", [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; ++i)
+					particles.Update(dt, emitter, perFrame, glm::vec2(6.25f));
+			});
+			runner.Run("ParticleGenerator::Draw n=" + std::to_string(size), [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; ++i)
+				{
+					particles.Draw();
+					glFinish();
+				}
+			});
+
+			// dt = 0 keeps every particle alive, so each spawn has to make room by dropping the oldest
+			particles.Update(0.0f, emitter, size, glm::vec2(6.25f));
+			runner.Run("ParticleGenerator spawn into full pool n=" + std::to_string(size), [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; ++i)
+					particles.Update(0.0f, emitter, 1, glm::vec2(6.25f));
+			});
+			particles.Overflow = OVERFLOW_DROP_NEW;
+			runner.Run("ParticleGenerator spawn into full pool, drop new n=" + std::to_string(size), [&](uint64_t iterations)
+			{
+				for (uint64_t i = 0; i < iterations; ++i)
+					particles.Update(0.0f, emitter, 1, glm::vec2(6.25f));
+			});
+		}
+
+		// the game's emitters, with more brick bursts than the global cap allows so it is always in effect
+		ParticleSystem system(particleShader, particleTexture, 2000);
+		unsigned int trail = system.AddEmitter(500, 1, 1.0f, 2.5f, 120.0f);
+		unsigned int bricks = system.AddEmitter(2000, 0, 0.6f, 1.6f);
+		unsigned int pickups = system.AddEmitter(500, 2, 0.8f, 1.25f);
+		system.Seed(42, 1);
+		auto systemFrame = [&](unsigned int frame)
+		{
+			system.EmitOverTime(trail, dt, emitter, glm::vec2(6.25f));
+			system.Burst(bricks, 64, glm::vec2(frame % SCENE_WIDTH, 40.0f), 150.0f, glm::vec3(0.8f, 0.4f, 0.2f));
+			if (frame % 30 == 0)
+				system.Burst(pickups, 40, glm::vec2(SCENE_WIDTH / 2.0f, 200.0f), 100.0f, glm::vec3(0.5f, 1.0f, 0.5f));
+			system.Update(dt);
+		};
+		for (unsigned int frame = 0; frame < 90; ++frame)
+			systemFrame(frame);
+		std::cout << "-- ParticleSystem: " << system.LiveCount() << " live of " << system.MaxLive << ", trail "
+			<< system.Emitter(trail).LiveCount() << ", bricks " << system.Emitter(bricks).LiveCount() << ", pickups "
+			<< system.Emitter(pickups).LiveCount() << ", " << system.Evicted << " evicted, " << system.Dropped << " dropped" << std::endl;
+
+		unsigned int frame = 90;
+		runner.Run("ParticleSystem game emitters at cap", [&](uint64_t iterations)
+		{
+			for (uint64_t i = 0; i < iterations; ++i)
+				systemFrame(frame++);
+		});
+		runner.Run("ParticleSystem::Draw game emitters", [&](uint64_t iterations)
+		{
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				system.Draw();
+				glFinish();
+			}
+		});
+
+		runner.Section("sprites");
+		runSpriteBenchmarks(runner, root);
+
+		runner.Section("post-processing");
+		runPostProcessBenchmarks(runner, root);
+
+		runner.Section("resources");
+		// empty resources named like the game's, under their own prefix: adding a name that is taken replaces
+		// the resource, and the earlier sections' renderers still draw with the real shaders
+		const std::string TEXTURES[] = { "bench_lookup_paddle", "bench_lookup_orb", "bench_lookup_background", "bench_lookup_block_solid",
+			"bench_lookup_block", "bench_lookup_particle", "bench_lookup_confuse_powerup", "bench_lookup_increase_powerup",
+			"bench_lookup_passthrough_powerup", "bench_lookup_speed_powerup", "bench_lookup_sticky_powerup", "bench_lookup_chaos_powerup" };
+		const std::string SHADERS[] = { "bench_lookup_sprite", "bench_lookup_particle", "bench_lookup_spritebatch", "bench_lookup_brick",
+			"bench_lookup_postprocess" };
+		TextureHandle textureHandles[12];
+		ShaderHandle shaderHandles[5];
+		for (unsigned int i = 0; i < 12; ++i)
+			textureHandles[i] = ResourceManager::AddTexture(Texture2D(), TEXTURES[i]);
+		for (unsigned int i = 0; i < 5; ++i)
+			shaderHandles[i] = ResourceManager::AddShader(Shader(), SHADERS[i]);
+
+		runner.Run("ResourceManager::GetTexture by name", [&](uint64_t iterations)
+		{
+			unsigned int sum = 0;
+			for (uint64_t i = 0; i < iterations; ++i)
+				sum += ResourceManager::GetTexture(TEXTURES[i % 12]).ID;
+			DoNotOptimize(sum);
+		});
+		runner.Run("ResourceManager::GetTexture by handle", [&](uint64_t iterations)
+		{
+			unsigned int sum = 0;
+			for (uint64_t i = 0; i < iterations; ++i)
+				sum += ResourceManager::GetTexture(textureHandles[i % 12]).ID;
+			DoNotOptimize(sum);
+		});
+		runner.Run("ResourceManager::GetShader by name", [&](uint64_t iterations)
+		{
+			unsigned int sum = 0;
+			for (uint64_t i = 0; i < iterations; ++i)
+				sum += ResourceManager::GetShader(SHADERS[i % 5]).ID;
+			DoNotOptimize(sum);
+		});
+		runner.Run("ResourceManager::GetShader by handle", [&](uint64_t iterations)
+		{
+			unsigned int sum = 0;
+			for (uint64_t i = 0; i < iterations; ++i)
+				sum += ResourceManager::GetShader(shaderHandles[i % 5]).ID;
+			DoNotOptimize(sum);
+		});
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteFramebuffers(1, &fbo);
+	glDeleteTextures(1, &color);
+	ResourceManager::Clear();
+	glfwDestroyWindow(window);
+	glfwTerminate();
+}
@@ -0,0 +1,140 @@
+#include "simpch.h"
+#include "Benchmark.h"
+#include "Simulation.h"
+#include "Collision.h"
+
+// a few thousand ball states taken from a scripted game, so collision benchmarks see the same
+// mix of hits and misses as real play
+static std::vector<BallObject> recordBallStates(const std::string& levels, unsigned int level, unsigned int count)
+{
+	Simulation sim(1080, 720, 1);
+	sim.LoadLevel((levels + "one.lvl").c_str());
+	sim.LoadLevel((levels + "two.lvl").c_str());
+	sim.Level = level;
+
+	std::vector<BallObject> states;
+	SimInput input;
+	input.Launch = true;
+	for (unsigned int step = 0; states.size() < count; ++step)
+	{
+		// sweep the paddle back and forth so the ball keeps getting returned
+		input.Left = (step / 120) % 2 == 0;
+		input.Right = !input.Left;
+		sim.Step(input, 1.0f / 240.0f);
+		states.push_back(sim.Ball);
+	}
+	return states;
+}
+
+void RunSimBenchmarks(BenchmarkRunner& runner, const std::string& root)
+{
+	const std::string levels = root + "Source/Breakout/Levels/";
+	Pcg32 rng(42);
+
+	// random shapes for the narrow phase tests
+	const unsigned int SHAPES = 1024;
+	std::vector<BallObject> balls(SHAPES);
+	std::vector<GameObject> boxes(SHAPES);
+	std::vector<glm::vec2> vectors(SHAPES);
+	for (unsigned int i = 0; i < SHAPES; ++i)
+	{
+		balls[i] = BallObject(glm::vec2(rng.NextFloat() * 200.0f, rng.NextFloat() * 200.0f), 12.5f, glm::vec2(0.0f));
+		boxes[i] = GameObject(glm::vec2(rng.NextFloat() * 200.0f, rng.NextFloat() * 200.0f), glm::vec2(72.0f, 45.0f));
+		vectors[i] = glm::vec2(rng.NextFloat() * 2.0f - 1.0f, rng.NextFloat() * 2.0f - 1.0f);
+	}
+
+	runner.Section("collision");
+	runner.Run("CheckCollision circle-AABB", [&](uint64_t iterations)
+	{
+		unsigned int hits = 0;
+		for (uint64_t i = 0; i < iterations; ++i)
+			hits += std::get<0>(CheckCollision(balls[i % SHAPES], boxes[(i * 7) % SHAPES]));
+		DoNotOptimize(hits);
+	});
+	runner.Run("CheckCollision AABB-AABB", [&](uint64_t iterations)
+	{
+		unsigned int hits = 0;
+		for (uint64_t i = 0; i < iterations; ++i)
+			hits += CheckCollision(static_cast<GameObject&>(balls[i % SHAPES]), boxes[(i * 7) % SHAPES]) ? 1 : 0;
+		DoNotOptimize(hits);
+	});
+	runner.Run("VectorDirection", [&](uint64_t iterations)
+	{
+		unsigned int sum = 0;
+		for (uint64_t i = 0; i < iterations; ++i)
+			sum += VectorDirection(vectors[i % SHAPES]);
+		DoNotOptimize(sum);
+	});
+
+	const char* LEVEL_NAMES[] = { "one", "two" };
+	for (unsigned int level = 0; level < 2; ++level)
+	{
+		std::vector<BallObject> states = recordBallStates(levels, level, 4096);
+		Simulation sim(1080, 720, 7);
+		sim.LoadLevel((levels + "one.lvl").c_str());
+		sim.LoadLevel((levels + "two.lvl").c_str());
+		sim.Level = level;
+
+		// bricks, power-ups, events and the shake are put back after every call so each op sees the same
+		// level; Update would clear the events and fire the shake timers, DoCollision alone only adds them
+		runner.Run(std::string("Simulation::DoCollision level ") + LEVEL_NAMES[level], [&](uint64_t iterations)
+		{
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				sim.Ball = states[i % states.size()];
+				sim.DoCollision();
+				sim.Levels[level].ResetBricks();
+				sim.PowerUps.Clear();
+				sim.Events.clear();
+				sim.Timers.Clear();
+				sim.ShakeEnd = 0.0;
+				sim.Shake = false;
+			}
+			DoNotOptimize(sim.Ball.Position);
+		});
+	}
+
+	runner.Section("simulation");
+	{
+		Simulation sim(1080, 720, 3);
+		sim.LoadLevel((levels + "one.lvl").c_str());
+		sim.LoadLevel((levels + "two.lvl").c_str());
+		SimInput input;
+		input.Launch = true;
+		runner.Run("Simulation::Step 240Hz", [&](uint64_t iterations)
+		{
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				input.Left = (i / 120) % 2 == 0;
+				input.Right = !input.Left;
+				sim.Step(input, 1.0f / 240.0f);
+			}
+			DoNotOptimize(sim.Ball.Position);
+		});
+
+		SimSnapshot snapshot;
+		sim.SaveSnapshot(snapshot);
+		runner.Run("Simulation save+restore snapshot", [&](uint64_t iterations)
+		{
+			for (uint64_t i = 0; i < iterations; ++i)
+			{
+				sim.SaveSnapshot(snapshot);
+				sim.RestoreSnapshot(snapshot);
+			}
+			DoNotOptimize(sim.Ball.Position);
+		});
+	}
+
+	runner.Section("levels");
+	for (unsigned int level = 0; level < 2; ++level)
+	{
+		std::string file = levels + LEVEL_NAMES[level] + ".lvl";
+		GameLevel gameLevel;
+		runner.Run(std::string("GameLevel::Load ") + LEVEL_NAMES[level], [&](uint64_t iterations)
+		{
+			for (uint64_t i = 0; i < iterations; ++i)
+				gameLevel.Load(file.c_str(), 1080, 360);
+			DoNotOptimize(gameLevel.Bricks.size());
+		});
+	}
+}
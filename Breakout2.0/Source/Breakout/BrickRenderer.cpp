@@ -0,0 +1,148 @@
+#include "pch.h"
+#include "GLState.h"
+#include "BrickRenderer.h"
+
+// changed bricks Sync still patches run by run, beyond it one upload spans them all
+const unsigned int MAX_BRICK_PATCHES = 16;
+
+BrickRenderer::BrickRenderer(Shader& shader)
+	:Uploads(0), UploadCalls(0), shader(shader), level(nullptr), layoutId(0), count(0)
+{
+	initRenderData();
+}
+
+BrickRenderer::~BrickRenderer()
+{
+	GLState::DeleteVertexArray(VAO);
+	GLState::DeleteBuffer(quadVBO);
+	GLState::DeleteBuffer(instanceVBO);
+}
+
+void BrickRenderer::Sync(const GameLevel& level)
+{
+	if (&level != this->level || level.LayoutId != layoutId)
+	{
+		upload(level);
+		return;
+	}
+
+	// only bricks whose destroyed bit flipped since the last sync get rewritten
+	changed.clear();
+	for (unsigned int word = 0; word < destroyed.size(); ++word)
+	{
+		uint64_t flipped = destroyed[word] ^ level.DestroyedBits[word];
+		while (flipped)
+		{
+			unsigned int bit = 0;
+			while (!((flipped >> bit) & 1))
+				++bit;
+			flipped &= flipped - 1;
+
+			unsigned int brick = word * 64 + bit;
+			instances[brick].Alive = level.IsDestroyed(brick) ? 0.0f : 1.0f;
+			changed.push_back(brick);
+		}
+		destroyed[word] = level.DestroyedBits[word];
+	}
+	if (changed.empty())
+		return;
+
+	GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	// after a reset nearly every brick flips, a call per run would be a call per brick
+	if (changed.size() > MAX_BRICK_PATCHES)
+	{
+		uploadRange(changed.front(), changed.back() + 1);
+		return;
+	}
+	// a few scattered bricks, neighbours share one call
+	unsigned int run = 0;
+	for (unsigned int i = 1; i <= changed.size(); ++i)
+	{
+		if (i == changed.size() || changed[i] != changed[i - 1] + 1)
+		{
+			uploadRange(changed[run], changed[i - 1] + 1);
+			run = i;
+		}
+	}
+}
+
+void BrickRenderer::Draw(TextureView block, TextureView blockSolid)
+{
+	if (count == 0)
+		return;
+
+	shader.Use();
+	GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	block.Bind(0);
+	blockSolid.Bind(1);
+
+	GLState::BindVertexArray(VAO);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+}
+
+void BrickRenderer::upload(const GameLevel& level)
+{
+	instances.resize(level.Bricks.size());
+	for (unsigned int i = 0; i < instances.size(); ++i)
+	{
+		const GameObject& brick = level.Bricks[i];
+		instances[i].Position = brick.Position;
+		instances[i].Size = brick.Size;
+		instances[i].Color = brick.Color;
+		instances[i].Solid = brick.IsSolid ? 1.0f : 0.0f;
+		instances[i].Alive = level.IsDestroyed(i) ? 0.0f : 1.0f;
+	}
+
+	GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(BrickInstance), instances.data(), GL_STATIC_DRAW);
+
+	this->level = &level;
+	layoutId = level.LayoutId;
+	count = static_cast<unsigned int>(instances.size());
+	destroyed = level.DestroyedBits;
+	Uploads += count;
+	++UploadCalls;
+}
+
+void BrickRenderer::uploadRange(unsigned int first, unsigned int end)
+{
+	glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(BrickInstance), (end - first) * sizeof(BrickInstance), &instances[first]);
+	Uploads += end - first;
+	++UploadCalls;
+}
+
+void BrickRenderer::initRenderData()
+{
+	// same quad as SpriteRenderer so the bricks rasterize exactly like sprites
+	float vertices[] = {
+		0.0f, 1.0f,
+		1.0f, 0.0f,
+		0.0f, 0.0f,
+		0.0f, 1.0f,
+		1.0f, 1.0f,
+		1.0f, 0.0f
+	};
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &quadVBO);
+	glGenBuffers(1, &instanceVBO);
+	GLState::BindVertexArray(VAO);
+
+	GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+
+	// one BrickInstance per brick, advanced once per instance; position and size go in as one vec4
+	GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(BrickInstance), (void*)offsetof(BrickInstance, Position));
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(BrickInstance), (void*)offsetof(BrickInstance, Color));
+	glVertexAttribDivisor(2, 1);
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(BrickInstance), (void*)offsetof(BrickInstance, Solid));
+	glVertexAttribDivisor(3, 1);
+
+}
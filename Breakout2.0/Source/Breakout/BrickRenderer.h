@@ -0,0 +1,50 @@
+#pragma once
+#include <Shader.h>
+#include <Texture.h>
+#include <GameLevel.h>
+
+// Draws a level's whole brick wall with one instanced call. The bricks are uploaded once per
+// layout; afterwards Sync only patches the instances whose destroyed bit changed.
+class BrickRenderer
+{
+public:
+	BrickRenderer(Shader& shader);
+	~BrickRenderer();
+
+	BrickRenderer(const BrickRenderer&) = delete;
+	BrickRenderer& operator=(const BrickRenderer&) = delete;
+
+	// brings the instance buffer up to date with the level, call before Draw
+	void Sync(const GameLevel& level);
+	void Draw(TextureView block, TextureView blockSolid);
+
+	// instances rewritten by Sync since the last ResetStats, a full upload counts every brick,
+	// and the buffer uploads it took to write them
+	unsigned int Uploads, UploadCalls;
+	void ResetStats() { Uploads = 0; UploadCalls = 0; }
+private:
+	struct BrickInstance
+	{
+		glm::vec2 Position, Size;
+		glm::vec3 Color;
+		float Solid;
+		float Alive;
+	};
+
+	Shader& shader;
+	unsigned int VAO, quadVBO, instanceVBO;
+
+	// what the instance buffer currently holds, and a copy of it to upload patched ranges from
+	const GameLevel* level;
+	unsigned int layoutId;
+	unsigned int count;
+	std::vector<uint64_t> destroyed;
+	std::vector<BrickInstance> instances;
+	// bricks the current Sync found flipped, kept to reuse its storage
+	std::vector<unsigned int> changed;
+
+	void upload(const GameLevel& level);
+	// rewrites instances [first, end) of the buffer bound to GL_ARRAY_BUFFER
+	void uploadRange(unsigned int first, unsigned int end);
+	void initRenderData();
+};
@@ -0,0 +1,24 @@
+#include "pch.h"
+#include "GLState.h"
+#include "FrameData.h"
+
+static_assert(sizeof(FrameData) == 80, "FrameData has to match the std140 layout of the shaders' FrameData block");
+
+FrameUniforms::FrameUniforms()
+{
+	glGenBuffers(1, &UBO);
+	GLState::BindBuffer(GL_UNIFORM_BUFFER, UBO);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+	glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, UBO);
+}
+
+FrameUniforms::~FrameUniforms()
+{
+	GLState::DeleteBuffer(UBO);
+}
+
+void FrameUniforms::Update(const FrameData& data)
+{
+	GLState::BindBuffer(GL_UNIFORM_BUFFER, UBO);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+// uniform buffer binding point of the FrameData block
+const unsigned int FRAME_DATA_BINDING = 0;
+
+// Values every shader shares for a frame, laid out like the std140 FrameData block the shaders declare:
+// a mat4 is four vec4 columns, the float after it starts a new 16 byte slot.
+struct FrameData
+{
+	glm::mat4 Projection;
+	float Time;
+	float padding[3];
+};
+
+// Owns the uniform buffer behind the FrameData block and keeps it bound to FRAME_DATA_BINDING,
+// so one upload per frame reaches every shader without touching their uniforms.
+class FrameUniforms
+{
+public:
+	FrameUniforms();
+	~FrameUniforms();
+
+	FrameUniforms(const FrameUniforms&) = delete;
+	FrameUniforms& operator=(const FrameUniforms&) = delete;
+
+	void Update(const FrameData& data);
+private:
+	unsigned int UBO;
+};
+
@@ -0,0 +1,143 @@
+#include "pch.h"
+#include "GLState.h"
+
+// what the cache holds for state it knows nothing about, never a valid name
+static const unsigned int UNKNOWN = ~0u;
+
+unsigned int GLState::Issued = 0;
+unsigned int GLState::Elided = 0;
+unsigned int GLState::program = UNKNOWN;
+unsigned int GLState::activeUnit = UNKNOWN;
+unsigned int GLState::textures[GLState::MAX_TEXTURE_UNITS] = { UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN };
+unsigned int GLState::vertexArray = UNKNOWN;
+unsigned int GLState::arrayBuffer = UNKNOWN;
+unsigned int GLState::uniformBuffer = UNKNOWN;
+unsigned int GLState::blendSource = UNKNOWN;
+unsigned int GLState::blendDestination = UNKNOWN;
+
+void GLState::UseProgram(unsigned int program)
+{
+	if (GLState::program == program)
+	{
+		++Elided;
+		return;
+	}
+	glUseProgram(program);
+	GLState::program = program;
+	++Issued;
+}
+
+void GLState::BindTexture(unsigned int unit, unsigned int texture)
+{
+	activeTexture(unit);
+	if (textures[unit] == texture)
+	{
+		++Elided;
+		return;
+	}
+	glBindTexture(GL_TEXTURE_2D, texture);
+	textures[unit] = texture;
+	++Issued;
+}
+
+void GLState::BindVertexArray(unsigned int VAO)
+{
+	if (vertexArray == VAO)
+	{
+		++Elided;
+		return;
+	}
+	glBindVertexArray(VAO);
+	vertexArray = VAO;
+	++Issued;
+}
+
+void GLState::BindBuffer(unsigned int target, unsigned int buffer)
+{
+	unsigned int* bound = target == GL_ARRAY_BUFFER ? &arrayBuffer : target == GL_UNIFORM_BUFFER ? &uniformBuffer : nullptr;
+	if (bound && *bound == buffer)
+	{
+		++Elided;
+		return;
+	}
+	glBindBuffer(target, buffer);
+	if (bound)
+		*bound = buffer;
+	++Issued;
+}
+
+void GLState::BlendFunc(unsigned int source, unsigned int destination)
+{
+	if (blendSource == source && blendDestination == destination)
+	{
+		++Elided;
+		return;
+	}
+	glBlendFunc(source, destination);
+	blendSource = source;
+	blendDestination = destination;
+	++Issued;
+}
+
+void GLState::DeleteProgram(unsigned int program)
+{
+	glDeleteProgram(program);
+	// a program in use lives on until another one replaces it, so the cached one is not trusted either way
+	if (GLState::program == program)
+		GLState::program = UNKNOWN;
+}
+
+// GL unbinds deleted textures, vertex arrays and buffers from the current context itself
+void GLState::DeleteTexture(unsigned int texture)
+{
+	glDeleteTextures(1, &texture);
+	for (unsigned int& bound : textures)
+		if (bound == texture)
+			bound = 0;
+}
+
+void GLState::DeleteVertexArray(unsigned int VAO)
+{
+	glDeleteVertexArrays(1, &VAO);
+	if (vertexArray == VAO)
+		vertexArray = 0;
+}
+
+void GLState::DeleteBuffer(unsigned int buffer)
+{
+	glDeleteBuffers(1, &buffer);
+	if (arrayBuffer == buffer)
+		arrayBuffer = 0;
+	if (uniformBuffer == buffer)
+		uniformBuffer = 0;
+}
+
+void GLState::Invalidate()
+{
+	program = UNKNOWN;
+	activeUnit = UNKNOWN;
+	std::fill(textures, textures + MAX_TEXTURE_UNITS, UNKNOWN);
+	vertexArray = UNKNOWN;
+	arrayBuffer = UNKNOWN;
+	uniformBuffer = UNKNOWN;
+	blendSource = UNKNOWN;
+	blendDestination = UNKNOWN;
+}
+
+void GLState::ResetStats()
+{
+	Issued = 0;
+	Elided = 0;
+}
+
+void GLState::activeTexture(unsigned int unit)
+{
+	if (activeUnit == unit)
+	{
+		++Elided;
+		return;
+	}
+	glActiveTexture(GL_TEXTURE0 + unit);
+	activeUnit = unit;
+	++Issued;
+}
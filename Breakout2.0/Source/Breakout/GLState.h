@@ -0,0 +1,44 @@
+#pragma once
+
+// Cache of the GL state the renderers touch every draw: program, texture bindings, vertex array,
+// array/uniform buffer bindings and blend function. Every renderer sets what it needs through here
+// and never resets it afterwards, so a call asking for state that is already current never
+// reaches the driver. Code changing this state with plain gl calls has to Invalidate the cache.
+class GLState
+{
+public:
+	static const unsigned int MAX_TEXTURE_UNITS = 8;
+
+	static void UseProgram(unsigned int program);
+	// makes unit active and binds the 2D texture to it, texture operations after it act on that texture
+	static void BindTexture(unsigned int unit, unsigned int texture);
+	static void BindVertexArray(unsigned int VAO);
+	// GL_ARRAY_BUFFER and GL_UNIFORM_BUFFER are cached, other targets are always issued
+	static void BindBuffer(unsigned int target, unsigned int buffer);
+	static void BlendFunc(unsigned int source, unsigned int destination);
+
+	// deleting through these keeps the cache from claiming a later object with a reused name is bound
+	static void DeleteProgram(unsigned int program);
+	static void DeleteTexture(unsigned int texture);
+	static void DeleteVertexArray(unsigned int VAO);
+	static void DeleteBuffer(unsigned int buffer);
+
+	// forgets everything, the next call of each kind is issued
+	static void Invalidate();
+
+	// calls passed on to GL and calls dropped as redundant since the last ResetStats, the game resets them every frame
+	static unsigned int Issued, Elided;
+	static void ResetStats();
+private:
+	GLState() { }
+
+	static void activeTexture(unsigned int unit);
+
+	static unsigned int program;
+	static unsigned int activeUnit;
+	static unsigned int textures[MAX_TEXTURE_UNITS];
+	static unsigned int vertexArray;
+	static unsigned int arrayBuffer, uniformBuffer;
+	static unsigned int blendSource, blendDestination;
+};
+
@@ -1,12 +1,6 @@
 #pragma once
-#include <GameLevel.h>
-#include <PowerUp.h>
-enum GameState
-{
-	GAME_ACTIVE,
-	GAME_MENU,
-	GAME_WIN
-};
+#include <Simulation.h>
+#include <Replay.h>
 
 class Game
 {
@@ -19,28 +13,46 @@ public:
 
 	Game(const Game&) = delete;
 public:
-	GameState State;
 	bool Keys[1024];
 	unsigned int Width, Height;
 
+	// headless game state, Game only feeds it input and renders it
+	Simulation Sim;
+
+	// seeds gameplay and (on a separate stream) particles, set before Init
+	uint64_t Seed;
+
+	// when set before Init, every simulation step is recorded to this replay file
+	std::string RecordFile;
+
+	// sprites go through one SpriteBatch instead of a draw call each, set before Init
+	bool BatchSprites = true;
+
+	// bright parts of the scene glow through a bloom EffectChain, set before Init
+	bool Bloom = false;
+
+	// when set, the last TraceFrames frames are written there as a Chrome trace on F12 and on exit
+	std::string TraceFile;
+	unsigned int TraceFrames = 120;
+	bool TraceRequested = false;
+
 	void Init();
 
 	void ProcessInput(float dt);
 	void Update(float dt);
-	void Render();
 
-	inline bool isRunning() { return Running; }
-	void DoCollision();
+	// advances cosmetic per frame state like particles, independent of the simulation rate
+	void UpdateParticles(float dt);
+
+	// alpha blends between the previous and the current simulation step (0 = previous, 1 = current)
+	void Render(float alpha = 1.0f);
+
+	// writes the profiler trace to TraceFile, needs a BREAKOUT_PROFILE build to contain anything
+	void WriteTrace();
+
+	inline bool isRunning() { return Running && !glfwWindowShouldClose(Window); }
 
 	void Clean();
-public:
-	std::vector<GameLevel> Levels;
-	std::vector<PowerUp> PowerUps;
-	unsigned int Level;
-	
-	void SpawnPowerUps(GameObject& block);
-	void UpdatePowerUps(float dt);
-	void ResetLevel();
 private:
 	Game();
 	~Game();
@@ -49,6 +61,12 @@ private:
 
 	GLFWwindow* Window;
 	bool Running = true;
+
+	ReplayWriter Recorder;
+
+	// state before the last simulation step, used for render interpolation
+	glm::vec2 PrevBallPosition, PrevPaddlePosition;
+	float LastStep = 0.0f;
 private:
 	//  GLFW Callbacks
 	static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mode)
@@ -56,6 +74,8 @@ private:
 		// when a user presses the escape key, we set the WindowShouldClose property to true, closing the application
 		if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
 			glfwSetWindowShouldClose(window, true);
+		if (key == GLFW_KEY_F12 && action == GLFW_PRESS)
+			getInstance().TraceRequested = true;
 		if (key >= 0 && key < 1024)
 		{
 			if (action == GLFW_PRESS)
@@ -1,56 +1,209 @@
 #include "pch.h"
+#include "GLState.h"
 #include "ParticleGenerator.h"
+#include <Profiler.h>
 
-ParticleGenerator::ParticleGenerator(Shader shader, Texture2D texture, unsigned int nParticles)
-	:shader(shader), texture(texture), nr_particles(nParticles)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define PARTICLES_AVX
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLES_SSE2
+#endif
+
+static inline unsigned int countBits(unsigned int mask)
 {
-	init();
+	unsigned int bits = 0;
+	for (; mask; mask &= mask - 1)
+		++bits;
+	return bits;
 }
 
-void ParticleGenerator::Update(float dt, GameObject& object, unsigned int newParticles, glm::vec2 offset)
+// Ages `count` particles by dt: life decays, alpha fades and positions move against their velocity.
+// Particles that die this step move too, they are compacted away right after. Returns how many died.
+static unsigned int updateParticles(float* position, const float* velocity, float* alpha, float* life, unsigned int count, float dt, float fadeRate)
 {
-	// add new particles
-	for (unsigned int i = 0; i < newParticles; i++)
+	const float fade = dt * fadeRate;
+	unsigned int dead = 0;
+	unsigned int i = 0;
+#ifdef PARTICLES_AVX
 	{
-		int freeParticle = firstUnusedParticle();
-		respawnParticle(particles[freeParticle], object, offset);
+		const __m256 step = _mm256_set1_ps(dt), fadeStep = _mm256_set1_ps(fade), zero = _mm256_setzero_ps();
+		for (; i + 8 <= count; i += 8)
+		{
+			__m256 l = _mm256_sub_ps(_mm256_loadu_ps(life + i), step);
+			_mm256_storeu_ps(life + i, l);
+			dead += countBits(static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(l, zero, _CMP_LE_OQ))));
+			_mm256_storeu_ps(alpha + i, _mm256_sub_ps(_mm256_loadu_ps(alpha + i), fadeStep));
+			// x and y are interleaved and move the same way, so 8 particles are two full vectors
+			float* p = position + i * 2;
+			const float* v = velocity + i * 2;
+			_mm256_storeu_ps(p, _mm256_sub_ps(_mm256_loadu_ps(p), _mm256_mul_ps(_mm256_loadu_ps(v), step)));
+			_mm256_storeu_ps(p + 8, _mm256_sub_ps(_mm256_loadu_ps(p + 8), _mm256_mul_ps(_mm256_loadu_ps(v + 8), step)));
+		}
 	}
-
-	// update all particles
-	for (unsigned int i = 0; i < nr_particles; i++ )
+#endif
+#ifdef PARTICLES_SSE2
 	{
-		Particle& p = particles[i];
-		p.Life -= dt; // ooh so that it's life is determined by the time
-		if (p.Life > 0.0f)
+		const __m128 step = _mm_set1_ps(dt), fadeStep = _mm_set1_ps(fade), zero = _mm_setzero_ps();
+		for (; i + 4 <= count; i += 4)
 		{
-			p.Position -= p.Velocity * dt;
-			p.Color.a -= dt * 2.5f;
+			__m128 l = _mm_sub_ps(_mm_loadu_ps(life + i), step);
+			_mm_storeu_ps(life + i, l);
+			dead += countBits(static_cast<unsigned int>(_mm_movemask_ps(_mm_cmple_ps(l, zero))));
+			_mm_storeu_ps(alpha + i, _mm_sub_ps(_mm_loadu_ps(alpha + i), fadeStep));
+			float* p = position + i * 2;
+			const float* v = velocity + i * 2;
+			_mm_storeu_ps(p, _mm_sub_ps(_mm_loadu_ps(p), _mm_mul_ps(_mm_loadu_ps(v), step)));
+			_mm_storeu_ps(p + 4, _mm_sub_ps(_mm_loadu_ps(p + 4), _mm_mul_ps(_mm_loadu_ps(v + 4), step)));
 		}
 	}
+#endif
+	for (; i < count; ++i)
+	{
+		life[i] -= dt;
+		if (life[i] <= 0.0f)
+			++dead;
+		alpha[i] -= fade;
+		position[i * 2] -= velocity[i * 2] * dt;
+		position[i * 2 + 1] -= velocity[i * 2 + 1] * dt;
+	}
+	return dead;
 }
 
-void ParticleGenerator::Draw()
+ParticleGenerator::ParticleGenerator(Shader& shader, TextureView texture, unsigned int nParticles, ParticleOverflow overflow)
+	:Overflow(overflow), Lifetime(1.0f), FadeRate(2.5f), Saturated(0), Grown(0), Dropped(0), nr_particles(nParticles),
+	external(false), first(0), end(0), VAO(0), instanceVBO(0), texture(texture), shader(shader)
 {
-	shader.Use();
-	// blend function to give it a glow effect
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-	for (Particle& particle : particles)
+	storage.resize(ArenaFloats(nr_particles));
+	bind(storage.data());
+	CreateRenderData(VAO, instanceVBO, nr_particles);
+}
+
+ParticleGenerator::ParticleGenerator(Shader& shader, TextureView texture, float* arena, unsigned int nParticles, ParticleOverflow overflow)
+	:Overflow(overflow), Lifetime(1.0f), FadeRate(2.5f), Saturated(0), Grown(0), Dropped(0), nr_particles(nParticles),
+	external(true), first(0), end(0), VAO(0), instanceVBO(0), texture(texture), shader(shader)
+{
+	bind(arena);
+}
+
+ParticleGenerator::~ParticleGenerator()
+{
+	if (external)
+		return;
+	GLState::DeleteVertexArray(VAO);
+	GLState::DeleteBuffer(instanceVBO);
+}
+
+void ParticleGenerator::Update(float dt, GameObject& object, unsigned int newParticles, glm::vec2 offset)
+{
+	PROFILE_FUNCTION();
+	Emit(object, newParticles, offset);
+	Step(dt);
+}
+
+void ParticleGenerator::Emit(GameObject& object, unsigned int count, glm::vec2 offset)
+{
+	if (nr_particles == 0)
+		return;
+
+	if (count > nr_particles - LiveCount())
+		++Saturated;
+	for (unsigned int i = 0; i < count; i++)
+	{
+		unsigned int slot;
+		if (spawnSlot(slot))
+			respawnParticle(slot, object, offset);
+	}
+}
+
+void ParticleGenerator::Burst(unsigned int count, glm::vec2 origin, float speed, glm::vec3 tint)
+{
+	if (nr_particles == 0)
+		return;
+
+	if (count > nr_particles - LiveCount())
+		++Saturated;
+	for (unsigned int i = 0; i < count; i++)
 	{
-		if (particle.Life <= 0.0f)
+		unsigned int slot;
+		if (!spawnSlot(slot))
 			continue;
-		shader.SetVector2f("offset", particle.Position);
-		shader.SetVector4f("color", particle.Color);
-		texture.Bind();
-		glBindVertexArray(VAO);
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-		glBindVertexArray(0);
+		float angle = rng.NextFloat() * 6.28318530718f;
+		float magnitude = speed * (0.5f + 0.5f * rng.NextFloat());
+		position[slot * 2] = origin.x;
+		position[slot * 2 + 1] = origin.y;
+		// particles move against their velocity
+		velocity[slot * 2] = -std::cos(angle) * magnitude;
+		velocity[slot * 2 + 1] = -std::sin(angle) * magnitude;
+		color[slot * 3] = tint.r;
+		color[slot * 3 + 1] = tint.g;
+		color[slot * 3 + 2] = tint.b;
+		alpha[slot] = 1.0f;
+		life[slot] = Lifetime;
+	}
+}
+
+void ParticleGenerator::Step(float dt)
+{
+	if (first == end)
+		return;
+
+	unsigned int dead = updateParticles(position + first * 2, velocity + first * 2, alpha + first, life + first, end - first, dt, FadeRate);
+
+	// every particle lives equally long, so the dead ones are normally just the oldest at the front
+	while (dead > 0 && life[first] <= 0.0f)
+	{
+		++first;
+		--dead;
 	}
-	//reset the binding mode
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	if (dead > 0)
+		compact();
+	if (first == end)
+		first = end = 0;
 }
 
+unsigned int ParticleGenerator::Evict(unsigned int count)
+{
+	unsigned int evicted = std::min(count, end - first);
+	first += evicted;
+	Dropped += evicted;
+	if (first == end)
+		first = end = 0;
+	return evicted;
+}
 
-void ParticleGenerator::init()
+void ParticleGenerator::Seed(uint64_t seed, uint64_t stream)
+{
+	rng.Seed(seed, stream);
+}
+
+void ParticleGenerator::Draw()
+{
+	PROFILE_FUNCTION();
+	unsigned int live = end - first;
+	if (external || live == 0)
+		return;
+
+	// the live range goes up as it is: offsets, then colors, then alphas
+	GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	// orphan last frame's storage so the upload never waits on the previous draw
+	glBufferData(GL_ARRAY_BUFFER, nr_particles * 6 * sizeof(float), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, live * 2 * sizeof(float), LivePositions());
+	glBufferSubData(GL_ARRAY_BUFFER, nr_particles * 2 * sizeof(float), live * 3 * sizeof(float), LiveColors());
+	glBufferSubData(GL_ARRAY_BUFFER, nr_particles * 5 * sizeof(float), live * sizeof(float), LiveAlphas());
+
+	shader.Use();
+	// blend function to give it a glow effect, whatever draws next sets its own
+	GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE);
+	texture.Bind(0);
+	GLState::BindVertexArray(VAO);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(live));
+}
+
+
+void ParticleGenerator::CreateRenderData(unsigned int& VAO, unsigned int& instanceVBO, unsigned int capacity)
 {
 	unsigned int VBO;
 
@@ -66,54 +219,151 @@ void ParticleGenerator::init()
 
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
-	glBindVertexArray(VAO);
+	GLState::BindVertexArray(VAO);
 	
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(particle_quad), particle_quad, GL_STATIC_DRAW);
 
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-	glBindVertexArray(0);
 
-	for (unsigned int i = 0; i < nr_particles; i++)
-	{
-		particles.push_back(Particle());
-	}
 
-	glDeleteBuffers(1, &VBO);
+	glGenBuffers(1, &instanceVBO);
+	SetInstanceLayout(VAO, instanceVBO, capacity);
+
+	// the VAO keeps the quad alive, but deleting it while the VAO is bound would detach it
+	GLState::BindVertexArray(0);
+	GLState::DeleteBuffer(VBO);
+}
+
+void ParticleGenerator::SetInstanceLayout(unsigned int VAO, unsigned int instanceVBO, unsigned int capacity)
+{
+	// per particle offset, color and alpha, each in its own block of the buffer, refilled by every Draw
+	GLState::BindVertexArray(VAO);
+	GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	glBufferData(GL_ARRAY_BUFFER, capacity * 6 * sizeof(float), nullptr, GL_STREAM_DRAW);
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+	glVertexAttribDivisor(1, 1);
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)(capacity * 2 * sizeof(float)));
+	glVertexAttribDivisor(2, 1);
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(float), (void*)(capacity * 5 * sizeof(float)));
+	glVertexAttribDivisor(3, 1);
+}
+
+void ParticleGenerator::ResetStats()
+{
+	Saturated = Grown = 0;
+	Dropped = 0;
 }
 
-unsigned int lastUsedParticle = 0;
-unsigned int ParticleGenerator::firstUnusedParticle()
+void ParticleGenerator::bind(float* storage)
 {
-	for (unsigned int i = lastUsedParticle; i < nr_particles; i++)
+	// each field gets twice the pool size, so the live range only has to slide back to the start
+	// once every nr_particles spawns
+	unsigned int slots = nr_particles * 2;
+	position = storage;
+	velocity = position + slots * 2;
+	color = velocity + slots * 2;
+	alpha = color + slots * 3;
+	life = alpha + slots;
+}
+
+bool ParticleGenerator::spawnSlot(unsigned int& slot)
+{
+	if (end - first == nr_particles)
 	{
-		if (particles[i].Life <= 0.0f)
+		if (Overflow == OVERFLOW_DROP_NEW)
 		{
-			lastUsedParticle = i;
-			return i;
+			++Dropped;
+			return false;
 		}
-	}
-	for (unsigned int i = 0; i < lastUsedParticle; ++i)
-	{
-		if (particles[i].Life <= 0.0f)
+		if (Overflow == OVERFLOW_GROW && !external)
+			grow();
+		else
 		{
-			lastUsedParticle = i;
-			return i;
+			// the oldest is always at the front, dropping it keeps the range in spawn order
+			++first;
+			++Dropped;
 		}
 	}
 
-	// if all particles are taken override the first one
-	lastUsedParticle = 0;
-	return 0;
+	if (end == nr_particles * 2)
+		slideToFront();
+	slot = end++;
+	return true;
+}
+
+void ParticleGenerator::slideToFront()
+{
+	unsigned int live = end - first;
+	std::copy(position + first * 2, position + end * 2, position);
+	std::copy(velocity + first * 2, velocity + end * 2, velocity);
+	std::copy(color + first * 3, color + end * 3, color);
+	std::copy(alpha + first, alpha + end, alpha);
+	std::copy(life + first, life + end, life);
+	first = 0;
+	end = live;
 }
 
-void ParticleGenerator::respawnParticle(Particle& particle, GameObject& object, glm::vec2 offset)
+void ParticleGenerator::grow()
 {
-	float random = ((rand() % 100) - 50) / 10.0f;
-	float rColor = 0.5f + ((rand() % 100) / 100.0f);
-	particle.Position = object.Position + random + offset;
-	particle.Color = glm::vec4(rColor, rColor, rColor, 1.0f);
-	particle.Life = 1.0f;
-	particle.Velocity = object.Velocity * 0.01f;
+	unsigned int live = end - first;
+	const float* oldPosition = position, * oldVelocity = velocity, * oldColor = color, * oldAlpha = alpha, * oldLife = life;
+
+	std::vector<float> larger(ArenaFloats(nr_particles * 2));
+	nr_particles *= 2;
+	bind(larger.data());
+	std::copy(oldPosition + first * 2, oldPosition + end * 2, position);
+	std::copy(oldVelocity + first * 2, oldVelocity + end * 2, velocity);
+	std::copy(oldColor + first * 3, oldColor + end * 3, color);
+	std::copy(oldAlpha + first, oldAlpha + end, alpha);
+	std::copy(oldLife + first, oldLife + end, life);
+	storage.swap(larger);
+	first = 0;
+	end = live;
+
+	// the instance blocks are laid out by pool size
+	SetInstanceLayout(VAO, instanceVBO, nr_particles);
+	++Grown;
+}
+
+void ParticleGenerator::respawnParticle(unsigned int slot, GameObject& object, glm::vec2 offset)
+{
+	float random = (static_cast<int>(rng.NextBounded(100)) - 50) / 10.0f;
+	float rColor = 0.5f + (rng.NextBounded(100) / 100.0f);
+	position[slot * 2] = object.Position.x + random + offset.x;
+	position[slot * 2 + 1] = object.Position.y + random + offset.y;
+	velocity[slot * 2] = object.Velocity.x * 0.01f;
+	velocity[slot * 2 + 1] = object.Velocity.y * 0.01f;
+	color[slot * 3] = color[slot * 3 + 1] = color[slot * 3 + 2] = rColor;
+	alpha[slot] = 1.0f;
+	life[slot] = Lifetime;
+}
+
+void ParticleGenerator::compact()
+{
+	// stable, so the live range stays in spawn order
+	unsigned int write = first;
+	for (unsigned int read = first; read < end; ++read)
+	{
+		if (life[read] <= 0.0f)
+			continue;
+		if (write != read)
+		{
+			position[write * 2] = position[read * 2];
+			position[write * 2 + 1] = position[read * 2 + 1];
+			velocity[write * 2] = velocity[read * 2];
+			velocity[write * 2 + 1] = velocity[read * 2 + 1];
+			color[write * 3] = color[read * 3];
+			color[write * 3 + 1] = color[read * 3 + 1];
+			color[write * 3 + 2] = color[read * 3 + 2];
+			alpha[write] = alpha[read];
+			life[write] = life[read];
+		}
+		++write;
+	}
+	end = write;
 }
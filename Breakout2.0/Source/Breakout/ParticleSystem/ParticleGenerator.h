@@ -2,36 +2,96 @@
 #include "GameObject.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "Random.h"
 
-struct Particle
+// what a full pool does with a particle that has no room
+enum ParticleOverflow
 {
-	glm::vec2 Position, Velocity;
-	glm::vec4 Color;
-	float Life;
-
-	Particle()
-		:Position(0.0f), Velocity(0.0f), Color(1.0f), Life(0.0f) {}
+	OVERFLOW_DROP_OLDEST, // the oldest live particle makes room
+	OVERFLOW_DROP_NEW,    // the new particle is not spawned
+	OVERFLOW_GROW         // the pool doubles in size
 };
 
+// Particles live in structure-of-arrays storage. The live ones always form the contiguous
+// range [first, first + LiveCount()) in spawn order, so Update's SIMD kernel and Draw's
+// upload only ever touch that range; dead particles are compacted away after every Update.
+// A generator either owns its storage and GL objects and draws itself, or it is an emitter
+// of a ParticleSystem: then its storage is a slab of the system's arena and the system draws it.
 class ParticleGenerator
 {
 public:
-	ParticleGenerator(Shader shader, Texture2D texture, unsigned int nParticles);
+	ParticleGenerator(Shader& shader, TextureView texture, unsigned int nParticles, ParticleOverflow overflow = OVERFLOW_DROP_OLDEST);
+	// emitter over an external slab of ArenaFloats(nParticles) floats, sharing the system's shader and
+	// texture; it cannot grow, so OVERFLOW_GROW drops the oldest instead, and has no GL objects of its own
+	ParticleGenerator(Shader& shader, TextureView texture, float* arena, unsigned int nParticles, ParticleOverflow overflow = OVERFLOW_DROP_OLDEST);
+	~ParticleGenerator();
+
+	ParticleGenerator(const ParticleGenerator&) = delete;
+	ParticleGenerator& operator=(const ParticleGenerator&) = delete;
 
+	// spawns newParticles trailing the object, then steps everything by dt
 	void Update(float dt, GameObject& object, unsigned int newParticles, glm::vec2 offset);
+	void Emit(GameObject& object, unsigned int count, glm::vec2 offset);
+	// count particles flying out of origin in random directions at up to speed
+	void Burst(unsigned int count, glm::vec2 origin, float speed, glm::vec3 tint);
+	void Step(float dt);
+	// drops up to count of the oldest particles, returns how many were dropped
+	unsigned int Evict(unsigned int count);
+	// draws every live particle with one instanced call, only for generators owning their storage
 	void Draw();
+
+	// particles only draw from their own cosmetic random stream, never from the gameplay one
+	void Seed(uint64_t seed, uint64_t stream);
+
+	inline unsigned int LiveCount() const { return end - first; }
+	inline unsigned int Capacity() const { return nr_particles; }
+	// the live range laid out like the instance buffer blocks: offsets (x, y), colors (r, g, b), alphas
+	inline const float* LivePositions() const { return position + first * 2; }
+	inline const float* LiveColors() const { return color + first * 3; }
+	inline const float* LiveAlphas() const { return alpha + first; }
+
+	// floats of storage a pool of nParticles needs
+	static inline unsigned int ArenaFloats(unsigned int nParticles) { return nParticles * 18; }
+	// quad VAO plus an instance buffer for capacity particles, in the blocks the particle shader reads
+	static void CreateRenderData(unsigned int& VAO, unsigned int& instanceVBO, unsigned int capacity);
+	static void SetInstanceLayout(unsigned int VAO, unsigned int instanceVBO, unsigned int capacity);
+
+	ParticleOverflow Overflow;
+	// seconds a new particle lives and alpha it loses per second
+	float Lifetime, FadeRate;
+
+	// counters since the last ResetStats: Updates that found the pool full, particles dropped
+	// (oldest evicted or new ones refused) and times the pool grew
+	unsigned int Saturated, Grown;
+	uint64_t Dropped;
+	void ResetStats();
 private:
-	void init();
+	void bind(float* storage);
 
 	unsigned int nr_particles;
-	std::vector<Particle> particles;
+	Pcg32 rng;
 
-	unsigned int firstUnusedParticle();
-	void respawnParticle(Particle& particle, GameObject& object, glm::vec2 offset);
+	// per particle fields, each nr_particles * 2 long; positions, velocities (x, y) and colors
+	// (r, g, b) are interleaved so they can be handed to the GPU as they are
+	std::vector<float> storage;
+	// storage lives in a ParticleSystem's arena
+	bool external;
+	float* position, * velocity;
+	float* color;
+	float* alpha, * life;
+	// live range, at most nr_particles long
+	unsigned int first, end;
+
+	// slot for a new particle, false if the overflow policy refuses it
+	bool spawnSlot(unsigned int& slot);
+	void slideToFront();
+	void grow();
+	void respawnParticle(unsigned int slot, GameObject& object, glm::vec2 offset);
+	void compact();
 private:
-	unsigned int VAO;
+	// 0 for emitters of a ParticleSystem
+	unsigned int VAO, instanceVBO;
 
-	Texture2D texture;
-	Shader shader;
+	TextureView texture;
+	Shader& shader;
 };
-
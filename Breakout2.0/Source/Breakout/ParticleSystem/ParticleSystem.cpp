@@ -0,0 +1,169 @@
+#include "pch.h"
+#include "GLState.h"
+#include "ParticleSystem.h"
+#include <Profiler.h>
+
+ParticleSystem::ParticleSystem(Shader& shader, TextureView texture, unsigned int maxLive)
+	:MaxLive(maxLive), Dropped(0), Evicted(0), seed(0), stream(0), shader(shader), texture(texture), VAO(0), instanceVBO(0), capacity(0)
+{
+}
+
+ParticleSystem::~ParticleSystem()
+{
+	if (VAO == 0)
+		return;
+	GLState::DeleteVertexArray(VAO);
+	GLState::DeleteBuffer(instanceVBO);
+}
+
+unsigned int ParticleSystem::AddEmitter(unsigned int budget, int priority, float lifetime, float fadeRate, float rate)
+{
+	if (!emitters.empty())
+	{
+		std::cout << "ERROR::PARTICLESYSTEM: Emitters have to be added before the first update" << std::endl;
+		return 0;
+	}
+	infos.push_back({ budget, priority, lifetime, fadeRate, rate, 0.0f });
+	return static_cast<unsigned int>(infos.size() - 1);
+}
+
+void ParticleSystem::Seed(uint64_t seed, uint64_t stream)
+{
+	this->seed = seed;
+	this->stream = stream;
+	// every emitter draws from its own stream
+	for (unsigned int i = 0; i < emitters.size(); ++i)
+		emitters[i]->Seed(seed, stream + i);
+}
+
+void ParticleSystem::EmitOverTime(unsigned int emitter, float dt, GameObject& object, glm::vec2 offset)
+{
+	build();
+	EmitterInfo& info = infos[emitter];
+	info.Pending += info.Rate * dt;
+	unsigned int count = static_cast<unsigned int>(info.Pending);
+	info.Pending -= count;
+	if (count > 0)
+		emitters[emitter]->Emit(object, admit(emitter, count), offset);
+}
+
+void ParticleSystem::Burst(unsigned int emitter, unsigned int count, glm::vec2 origin, float speed, glm::vec3 tint)
+{
+	build();
+	emitters[emitter]->Burst(admit(emitter, count), origin, speed, tint);
+}
+
+void ParticleSystem::Update(float dt)
+{
+	PROFILE_FUNCTION();
+	build();
+	for (std::unique_ptr<ParticleGenerator>& emitter : emitters)
+		emitter->Step(dt);
+}
+
+void ParticleSystem::Draw()
+{
+	PROFILE_FUNCTION();
+	unsigned int live = LiveCount();
+	if (live == 0)
+		return;
+
+	// every emitter's live range goes into the same blocks the particle shader reads, back to back
+	GLState::BindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	// orphan last frame's storage so the upload never waits on the previous draw
+	glBufferData(GL_ARRAY_BUFFER, capacity * 6 * sizeof(float), nullptr, GL_STREAM_DRAW);
+	unsigned int base = 0;
+	for (std::unique_ptr<ParticleGenerator>& emitter : emitters)
+	{
+		unsigned int count = emitter->LiveCount();
+		if (count == 0)
+			continue;
+		glBufferSubData(GL_ARRAY_BUFFER, base * 2 * sizeof(float), count * 2 * sizeof(float), emitter->LivePositions());
+		glBufferSubData(GL_ARRAY_BUFFER, (capacity * 2 + base * 3) * sizeof(float), count * 3 * sizeof(float), emitter->LiveColors());
+		glBufferSubData(GL_ARRAY_BUFFER, (capacity * 5 + base) * sizeof(float), count * sizeof(float), emitter->LiveAlphas());
+		base += count;
+	}
+
+	shader.Use();
+	// blend function to give it a glow effect, whatever draws next sets its own
+	GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE);
+	texture.Bind(0);
+	GLState::BindVertexArray(VAO);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, static_cast<GLsizei>(live));
+}
+
+unsigned int ParticleSystem::LiveCount() const
+{
+	unsigned int live = 0;
+	for (const std::unique_ptr<ParticleGenerator>& emitter : emitters)
+		live += emitter->LiveCount();
+	return live;
+}
+
+ParticleGenerator& ParticleSystem::Emitter(unsigned int emitter)
+{
+	build();
+	return *emitters[emitter];
+}
+
+void ParticleSystem::ResetStats()
+{
+	Dropped = Evicted = 0;
+	for (std::unique_ptr<ParticleGenerator>& emitter : emitters)
+		emitter->ResetStats();
+}
+
+unsigned int ParticleSystem::admit(unsigned int emitter, unsigned int count)
+{
+	// past its own budget an emitter replaces its own oldest particles, that does not add to the live count
+	ParticleGenerator& target = *emitters[emitter];
+	unsigned int added = std::min(count, target.Capacity() - target.LiveCount());
+	unsigned int live = LiveCount();
+	unsigned int room = live < MaxLive ? MaxLive - live : 0;
+	if (added <= room)
+		return count;
+
+	unsigned int needed = added - room;
+	for (unsigned int victim : byPriority)
+	{
+		if (infos[victim].Priority >= infos[emitter].Priority || needed == 0)
+			break;
+		unsigned int evicted = emitters[victim]->Evict(needed);
+		Evicted += evicted;
+		needed -= evicted;
+	}
+	if (needed == 0)
+		return count;
+
+	// new particles fill the emitter's free slots first, so only what still fits under the cap may spawn
+	unsigned int admitted = added - needed;
+	Dropped += count - admitted;
+	return admitted;
+}
+
+void ParticleSystem::build()
+{
+	if (!emitters.empty() || infos.empty())
+		return;
+
+	capacity = 0;
+	for (const EmitterInfo& info : infos)
+		capacity += info.Budget;
+	arena.resize(ParticleGenerator::ArenaFloats(capacity));
+
+	float* slab = arena.data();
+	for (unsigned int i = 0; i < infos.size(); ++i)
+	{
+		emitters.emplace_back(new ParticleGenerator(shader, texture, slab, infos[i].Budget));
+		emitters[i]->Lifetime = infos[i].Lifetime;
+		emitters[i]->FadeRate = infos[i].FadeRate;
+		emitters[i]->Seed(seed, stream + i);
+		slab += ParticleGenerator::ArenaFloats(infos[i].Budget);
+
+		byPriority.push_back(i);
+	}
+	std::stable_sort(byPriority.begin(), byPriority.end(),
+		[this](unsigned int a, unsigned int b) { return infos[a].Priority < infos[b].Priority; });
+
+	ParticleGenerator::CreateRenderData(VAO, instanceVBO, capacity);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "ParticleGenerator.h"
+
+// Owns every particle emitter of the game. The emitters are slabs of one arena allocated on first
+// use, each with its own budget, and live particles across all of them are capped: a new particle
+// that does not fit under the cap evicts the oldest of a lower priority emitter, or is dropped.
+// Continuous emission is by rate, so the particle load does not depend on the frame rate.
+class ParticleSystem
+{
+public:
+	ParticleSystem(Shader& shader, TextureView texture, unsigned int maxLive);
+	~ParticleSystem();
+
+	ParticleSystem(const ParticleSystem&) = delete;
+	ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+	// adds an emitter and returns its id, only before the first Emit/Burst/Update;
+	// rate is particles per second for EmitOverTime
+	unsigned int AddEmitter(unsigned int budget, int priority, float lifetime, float fadeRate, float rate = 0.0f);
+	void Seed(uint64_t seed, uint64_t stream);
+
+	// emits the emitter's share of dt worth of particles trailing the object
+	void EmitOverTime(unsigned int emitter, float dt, GameObject& object, glm::vec2 offset);
+	void Burst(unsigned int emitter, unsigned int count, glm::vec2 origin, float speed, glm::vec3 tint);
+	void Update(float dt);
+	// draws the particles of every emitter with one instanced call
+	void Draw();
+
+	unsigned int LiveCount() const;
+	ParticleGenerator& Emitter(unsigned int emitter);
+
+	unsigned int MaxLive;
+	// counters since the last ResetStats: particles refused by the global cap and particles
+	// of lower priority emitters evicted to make room
+	uint64_t Dropped, Evicted;
+	void ResetStats();
+private:
+	struct EmitterInfo
+	{
+		unsigned int Budget;
+		int Priority;
+		float Lifetime, FadeRate, Rate;
+		// fraction of a particle EmitOverTime still owes
+		float Pending;
+	};
+
+	std::vector<EmitterInfo> infos;
+	std::vector<std::unique_ptr<ParticleGenerator>> emitters;
+	std::vector<float> arena;
+	// emitter ids from the lowest priority up, the order admit evicts in
+	std::vector<unsigned int> byPriority;
+	uint64_t seed, stream;
+
+	// how many of count new particles the emitter may spawn under the global cap
+	unsigned int admit(unsigned int emitter, unsigned int count);
+	void build();
+
+	Shader& shader;
+	TextureView texture;
+	unsigned int VAO, instanceVBO;
+	// sum of the emitter budgets, what the instance buffer is laid out for
+	unsigned int capacity;
+};
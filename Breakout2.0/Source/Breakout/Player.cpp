@@ -1,6 +0,0 @@
-#include "pch.h"
-#include "Player.h"
-
-Player::Player(glm::vec2 pos, glm::vec2 size, Texture2D sprite, glm::vec3 color, glm::vec2 velocity) : GameObject(pos, size, sprite, color, velocity)
-{
-}
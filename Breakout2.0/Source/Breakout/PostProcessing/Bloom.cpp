@@ -0,0 +1,83 @@
+#include "pch.h"
+#include "Bloom.h"
+
+// scene brightness the bloom starts at
+const float BLOOM_THRESHOLD = 0.6f;
+const float BLOOM_INTENSITY = 0.8f;
+// in texels of the blurred target, a quarter resolution texel spans four of the screen's
+const float BLOOM_SIGMA = 2.5f;
+const unsigned int BLOOM_RADIUS = 6;
+
+BlurKernel GaussianKernel(float sigma, unsigned int radius, bool linearSampling)
+{
+	if (radius >= MAX_BLUR_TAPS)
+	{
+		std::cout << "ERROR::BLOOM: blur radius " << radius << " needs more than " << MAX_BLUR_TAPS << " taps" << std::endl;
+		radius = MAX_BLUR_TAPS - 1;
+	}
+
+	// one side of the kernel, normalized over both sides
+	float weights[MAX_BLUR_TAPS];
+	float sum = 0.0f;
+	for (unsigned int i = 0; i <= radius; ++i)
+	{
+		weights[i] = std::exp(-0.5f * (i * i) / (sigma * sigma));
+		sum += i == 0 ? weights[i] : 2.0f * weights[i];
+	}
+	for (unsigned int i = 0; i <= radius; ++i)
+		weights[i] /= sum;
+
+	BlurKernel kernel;
+	kernel.Taps = 1;
+	kernel.Weights[0] = weights[0];
+	kernel.Offsets[0] = 0.0f;
+	unsigned int step = linearSampling ? 2 : 1;
+	for (unsigned int i = 1; i <= radius; i += step)
+	{
+		// texels i and i + 1 fetched at once: the filter weighs them by how close the sample is to each
+		float weight = weights[i];
+		float offset = static_cast<float>(i);
+		if (linearSampling && i + 1 <= radius)
+		{
+			weight += weights[i + 1];
+			offset = (i * weights[i] + (i + 1) * weights[i + 1]) / weight;
+		}
+		kernel.Weights[kernel.Taps] = weight;
+		kernel.Offsets[kernel.Taps] = offset;
+		++kernel.Taps;
+	}
+	return kernel;
+}
+
+void SetBlurKernel(Shader& blur, const BlurKernel& kernel)
+{
+	blur.Use().SetInteger("taps", kernel.Taps);
+	glUniform1fv(blur.Location("weights"), kernel.Taps, kernel.Weights);
+	glUniform1fv(blur.Location("offsets"), kernel.Taps, kernel.Offsets);
+}
+
+int AddBloom(EffectChain& chain, const BloomShaders& shaders, float blurScale)
+{
+	shaders.BrightPass->Use().SetInteger("image", 0);
+	shaders.BrightPass->SetFloat("threshold", BLOOM_THRESHOLD);
+	shaders.Downsample->Use().SetInteger("image", 0);
+	shaders.Blur->Use().SetInteger("image", 0);
+	SetBlurKernel(*shaders.Blur, GaussianKernel(BLOOM_SIGMA, BLOOM_RADIUS, true));
+	shaders.Composite->Use().SetInteger("scene", 0);
+	shaders.Composite->SetInteger("bloom", 1);
+	shaders.Composite->SetFloat("intensity", BLOOM_INTENSITY);
+
+	// each step down halves the resolution at most, so every filtered fetch averages all the texels it covers
+	float brightScale = std::min(1.0f, 2.0f * blurScale);
+	chain.AddPass(*shaders.BrightPass, brightScale, { CHAIN_INPUT });
+	int bright = chain.PassCount() - 1;
+	if (brightScale != blurScale)
+	{
+		chain.AddPass(*shaders.Downsample, blurScale, { bright });
+		bright = chain.PassCount() - 1;
+	}
+	chain.AddPass(*shaders.Blur, blurScale, { bright }).Direction = glm::vec2(1.0f, 0.0f);
+	chain.AddPass(*shaders.Blur, blurScale, { bright + 1 }).Direction = glm::vec2(0.0f, 1.0f);
+	chain.AddPass(*shaders.Composite, 1.0f, { CHAIN_INPUT, bright + 2 }).Wrap = GL_REPEAT;
+	return chain.PassCount() - 1;
+}
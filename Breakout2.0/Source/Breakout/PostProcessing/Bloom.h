@@ -0,0 +1,36 @@
+#pragma once
+#include "Shader.h"
+#include "EffectChain.h"
+
+// most taps a blur pass samples per side, center included; the size of fsBlur's kernel arrays
+const unsigned int MAX_BLUR_TAPS = 16;
+
+// one direction of a Gaussian blur: the center tap and Taps - 1 taps mirrored on both sides of it,
+// Offsets in texels
+struct BlurKernel
+{
+	unsigned int Taps;
+	float Weights[MAX_BLUR_TAPS];
+	float Offsets[MAX_BLUR_TAPS];
+};
+
+// normalized Gaussian of sigma cut off after radius texels, radius below MAX_BLUR_TAPS. With
+// linearSampling each pair of neighbouring texels becomes one filtered fetch between them, placed by
+// their weights, which reads the same weighted sum with about half the taps.
+BlurKernel GaussianKernel(float sigma, unsigned int radius, bool linearSampling);
+// uploads kernel to a program built from fsBlur.shader
+void SetBlurKernel(Shader& blur, const BlurKernel& kernel);
+
+// programs the bloom passes draw with, all with vsEffect.shader
+struct BloomShaders
+{
+	Shader* BrightPass; // fsBrightPass.shader
+	Shader* Downsample; // fsDownsample.shader
+	Shader* Blur;       // fsBlur.shader
+	Shader* Composite;  // fsBloom.shader
+};
+
+// Appends bloom to chain: whatever in the chain input is bright enough, mostly the ball, power-ups and
+// particles, is extracted at half resolution, blurred at blurScale and added back at full resolution.
+// Configures the programs too. Returns the index of the final pass, which wraps like the scene texture.
+int AddBloom(EffectChain& chain, const BloomShaders& shaders, float blurScale = 0.25f);
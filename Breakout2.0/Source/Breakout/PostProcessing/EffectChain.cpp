@@ -0,0 +1,135 @@
+#include "pch.h"
+#include "GLState.h"
+#include "EffectChain.h"
+#include <Profiler.h>
+
+EffectChain::EffectChain(RenderTargetPool& pool)
+	:PixelsWritten(0), pool(pool)
+{
+	initRenderData();
+}
+
+EffectChain::~EffectChain()
+{
+	if (!outputs.empty() && outputs.back())
+		pool.Release(*outputs.back());
+	GLState::DeleteVertexArray(VAO);
+	GLState::DeleteBuffer(VBO);
+}
+
+EffectPass& EffectChain::AddPass(Shader& program, float scale, const std::vector<int>& inputs)
+{
+	int index = static_cast<int>(passes.size());
+	EffectPass pass;
+	pass.Program = &program;
+	pass.Scale = scale;
+	pass.Direction = glm::vec2(0.0f);
+	pass.Wrap = GL_CLAMP_TO_EDGE;
+	pass.TexelStep = program.GetUniform<glm::vec2>("texelStep");
+	for (int input : inputs)
+	{
+		if (input < CHAIN_INPUT || input >= index)
+		{
+			std::cout << "ERROR::EFFECTCHAIN: pass " << index << " reads pass " << input << ", which does not run before it" << std::endl;
+			continue;
+		}
+		pass.Inputs.push_back(input);
+		if (input != CHAIN_INPUT)
+			lastRead[input] = index;
+	}
+
+	passes.push_back(pass);
+	lastRead.push_back(index);
+	outputs.push_back(nullptr);
+	return passes.back();
+}
+
+TextureView EffectChain::Run(TextureView input, unsigned int width, unsigned int height)
+{
+	PROFILE_FUNCTION();
+	PixelsWritten = 0;
+	if (passes.empty())
+		return input;
+
+	// the previous result was kept for the caller until now
+	if (outputs.back())
+	{
+		pool.Release(*outputs.back());
+		outputs.back() = nullptr;
+	}
+
+	int viewport[4];
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	// every pass replaces its output
+	GLState::BlendFunc(GL_ONE, GL_ZERO);
+	GLState::BindVertexArray(VAO);
+
+	for (unsigned int i = 0; i < passes.size(); ++i)
+	{
+		EffectPass& pass = passes[i];
+		unsigned int passWidth = std::max(1u, static_cast<unsigned int>(width * pass.Scale + 0.5f));
+		unsigned int passHeight = std::max(1u, static_cast<unsigned int>(height * pass.Scale + 0.5f));
+		RenderTarget& target = pool.Acquire(passWidth, passHeight, pass.Wrap);
+		outputs[i] = &target;
+
+		glBindFramebuffer(GL_FRAMEBUFFER, target.FBO);
+		glViewport(0, 0, passWidth, passHeight);
+		pass.Program->Use();
+		for (unsigned int unit = 0; unit < pass.Inputs.size(); ++unit)
+		{
+			int source = pass.Inputs[unit];
+			TextureView view = source == CHAIN_INPUT ? input : outputs[source]->Texture.View();
+			view.Bind(unit);
+		}
+		if (pass.Direction != glm::vec2(0.0f) && !pass.Inputs.empty())
+		{
+			int source = pass.Inputs[0];
+			glm::vec2 size = source == CHAIN_INPUT ? glm::vec2(width, height) : glm::vec2(outputs[source]->Texture.Width, outputs[source]->Texture.Height);
+			pass.Program->Set(pass.TexelStep, pass.Direction / size);
+		}
+		glDrawArrays(GL_TRIANGLES, 0, 6);
+		PixelsWritten += static_cast<uint64_t>(passWidth) * passHeight;
+
+		// inputs nothing later reads are free for the next passes, and so is an output nothing reads
+		for (int source : pass.Inputs)
+		{
+			if (source != CHAIN_INPUT && lastRead[source] == i && outputs[source])
+			{
+				pool.Release(*outputs[source]);
+				outputs[source] = nullptr;
+			}
+		}
+		if (lastRead[i] == i && i + 1 < passes.size())
+		{
+			pool.Release(target);
+			outputs[i] = nullptr;
+		}
+	}
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+	return outputs.back()->Texture.View();
+}
+
+void EffectChain::initRenderData()
+{
+	float vertices[] = {
+		// pos        // tex
+		-1.0f, -1.0f, 0.0f, 0.0f,
+		 1.0f,  1.0f, 1.0f, 1.0f,
+		-1.0f,  1.0f, 0.0f, 1.0f,
+
+		-1.0f, -1.0f, 0.0f, 0.0f,
+		 1.0f, -1.0f, 1.0f, 0.0f,
+		 1.0f,  1.0f, 1.0f, 1.0f
+	};
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+
+	GLState::BindVertexArray(VAO);
+	GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "Shader.h"
+#include "Texture.h"
+#include "RenderTargetPool.h"
+
+// a pass input naming the texture the chain is run over rather than an earlier pass
+const int CHAIN_INPUT = -1;
+
+// one full screen draw of an EffectChain
+struct EffectPass
+{
+	Shader* Program;
+	// output size as a fraction of the chain's input, 0.5 and 0.25 for the downsampled passes
+	float Scale;
+	// CHAIN_INPUT or indices of earlier passes, bound to texture units 0, 1, ... in this order
+	std::vector<int> Inputs;
+	// for separable passes: when non zero the program's texelStep is set to Direction over the size of
+	// the first input, so one program serves both the horizontal and the vertical pass
+	glm::vec2 Direction;
+	// how the output is sampled outside [0, 1], the post-processing effects read the last pass wrapped
+	unsigned int Wrap;
+
+	Uniform<glm::vec2> TexelStep;
+};
+
+// Ordered full screen passes over a texture. Every pass renders into a target from the pool sized by
+// its Scale and reads the chain input or the outputs of earlier passes; a target goes back to the pool
+// right after the last pass reading it, so later passes of the same size reuse it.
+class EffectChain
+{
+public:
+	EffectChain(RenderTargetPool& pool);
+	~EffectChain();
+
+	EffectChain(const EffectChain&) = delete;
+	EffectChain& operator=(const EffectChain&) = delete;
+
+	// appends a pass drawn with program, its index is PassCount() - 1; the returned reference is
+	// valid until the next AddPass
+	EffectPass& AddPass(Shader& program, float scale, const std::vector<int>& inputs);
+	inline unsigned int PassCount() const { return static_cast<unsigned int>(passes.size()); }
+
+	// runs every pass over the width x height input and returns the last pass's output, which stays
+	// valid until the next Run; leaves the default framebuffer bound with the viewport it found
+	TextureView Run(TextureView input, unsigned int width, unsigned int height);
+
+	// pixels the passes of the last Run wrote, what the chain costs in fill rate
+	uint64_t PixelsWritten;
+private:
+	RenderTargetPool& pool;
+	std::vector<EffectPass> passes;
+	// index of the last pass reading each pass's output, the pass itself if none does
+	std::vector<unsigned int> lastRead;
+	// outputs of the current Run by pass
+	std::vector<RenderTarget*> outputs;
+
+	unsigned int VAO, VBO;
+
+	void initRenderData();
+};
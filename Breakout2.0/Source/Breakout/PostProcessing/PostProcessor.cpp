@@ -1,9 +1,22 @@
 #include "pch.h"
+#include "GLState.h"
 #include "PostProcessor.h"
-
-PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned int height)
-	:PostProcessingShader(shader), Texture(),  Width(width), Height(height), Confuse(false), Shake(false), Chaos(false)
+#include <Profiler.h>
+
+const PostProcessVariantInfo POSTPROCESS_VARIANTS[POSTPROCESS_VARIANT_COUNT] = {
+	{ "postprocess",               { } },
+	{ "postprocess_shake",         { "SHAKE" } },
+	{ "postprocess_confuse",       { "CONFUSE" } },
+	{ "postprocess_confuse_shake", { "CONFUSE", "SHAKE" } },
+	{ "postprocess_chaos",         { "CHAOS" } },
+	{ "postprocess_chaos_shake",   { "CHAOS", "SHAKE" } }
+};
+
+PostProcessor::PostProcessor(Shader* const variants[POSTPROCESS_VARIANT_COUNT], unsigned int width, unsigned int height)
+	:Texture(),  Width(width), Height(height), Confuse(false), Chaos(false), Shake(false), Chain(nullptr), directResolve(false), bypassed(false)
 {
+	std::copy(variants, variants + POSTPROCESS_VARIANT_COUNT, Variants);
+
 	// initialize renderbuffer/framebuffer object
 	glGenFramebuffers(1, &MSFBO);
 	glGenFramebuffers(1, &FBO);
@@ -13,21 +26,31 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned int hei
 	//texture
 	glBindFramebuffer(GL_FRAMEBUFFER, MSFBO);
 	glBindRenderbuffer(GL_RENDERBUFFER, RBO);
-	glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGB, width, height);
+	// RGBA8 like the window's backbuffer, a multisample resolve between different formats is an error
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, 4, GL_RGBA8, width, height);
 	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, RBO);
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		std::cout << "ERROR::POSTPROCESSOR: Failed to initialize MSFBO";
 
 	// initialze regular fbo w texture only used where MSFBO will blit data to; 
 	glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	Texture.Internal_Format = GL_RGBA8;
+	Texture.Image_Format = GL_RGBA;
 	Texture.Generate(width, height, NULL);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, Texture.ID, 0);
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		std::cout << "ERROR::POSTPROCESSOR: Failed to initialize FBO";
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+	// the resolve may only go straight to the screen if the backbuffer has the same format
+	int red = 0, green = 0, blue = 0, alpha = 0;
+	glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_RED_SIZE, &red);
+	glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_GREEN_SIZE, &green);
+	glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_BLUE_SIZE, &blue);
+	glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER, GL_BACK_LEFT, GL_FRAMEBUFFER_ATTACHMENT_ALPHA_SIZE, &alpha);
+	directResolve = red == 8 && green == 8 && blue == 8 && alpha == 8;
+
 	initRenderData();
-	PostProcessingShader.SetInteger("scene", 0, true);
 	float offset = 1.0f / 300.0f;
 	float offsets[9][2] = {
 		{ -offset,  offset  },  // top-left
@@ -40,64 +63,88 @@ PostProcessor::PostProcessor(Shader shader, unsigned int width, unsigned int hei
 		{  0.0f,   -offset  },  // bottom-center
 		{  offset, -offset  }   // bottom-right    
 	};
-	glUniform2fv(glGetUniformLocation(PostProcessingShader.ID, "offsets"), 9, (float*)offsets);
 	int edge_kernel[9] = {
 	   -1, -1, -1,
 	   -1,  8, -1,
 	   -1, -1, -1
 	};
-	glUniform1iv(glGetUniformLocation(this->PostProcessingShader.ID, "edge_kernel"), 9, edge_kernel);
 	float blur_kernel[9] = {
 		1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f,
 		2.0f / 16.0f, 4.0f / 16.0f, 2.0f / 16.0f,
 		1.0f / 16.0f, 2.0f / 16.0f, 1.0f / 16.0f
 	};
-	glUniform1fv(glGetUniformLocation(this->PostProcessingShader.ID, "blur_kernel"), 9, blur_kernel);
+	// every variant gets the same constants, the ones a variant compiled out are simply not found
+	for (Shader* shader : Variants)
+	{
+		shader->Use().SetInteger("scene", 0);
+		glUniform2fv(shader->Location("offsets"), 9, (float*)offsets);
+		glUniform1iv(shader->Location("edge_kernel"), 9, edge_kernel);
+		glUniform1fv(shader->Location("blur_kernel"), 9, blur_kernel);
+	}
 }
 
 PostProcessor::~PostProcessor()
 {
 	glDeleteFramebuffers(1, &FBO);
 	glDeleteFramebuffers(1, &MSFBO);
-	glDeleteVertexArrays(1, &VAO);
+	GLState::DeleteVertexArray(VAO);
+	GLState::DeleteBuffer(VBO);
 	glDeleteRenderbuffers(1, &RBO);
 }
 
 void PostProcessor::BeginRender()
 {
+	PROFILE_FUNCTION();
 	glBindFramebuffer(GL_FRAMEBUFFER, MSFBO);
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
+	// alpha stays at the cleared 1, so the scene is as opaque as it was in an RGB buffer wherever it gets resolved to
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_FALSE);
 }
 
 void PostProcessor::EndRender()
 {
+	PROFILE_FUNCTION();
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+	// the plain variant would only copy the texture to the screen, so with no effect active the
+	// resolve goes there directly and saves writing and reading back a full screen texture; a resolve
+	// cannot scale though, when the window's framebuffer has another size the quad pass stretches it
+	int framebufferWidth = 0, framebufferHeight = 0;
+	glfwGetFramebufferSize(glfwGetCurrentContext(), &framebufferWidth, &framebufferHeight);
+	bypassed = !Active() && !Chain && directResolve
+		&& static_cast<unsigned int>(framebufferWidth) == Width && static_cast<unsigned int>(framebufferHeight) == Height;
+
 	// now resolve the multismapled color buffer intot he intermediant buffer FBO 
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, MSFBO);
-	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, FBO);
+	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, bypassed ? 0 : FBO);
 	glBlitFramebuffer(0, 0, Width, Height, 0, 0, Width, Height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
-void PostProcessor::Render(float time)
+void PostProcessor::Render()
 {
-	PostProcessingShader.Use();
-	PostProcessingShader.SetFloat("time", time);
-	PostProcessingShader.SetInteger("confuse", Confuse);
-	PostProcessingShader.SetInteger("chaos", Chaos);
-	PostProcessingShader.SetInteger("shake", Shake);
+	PROFILE_FUNCTION();
+	if (bypassed)
+		return;
+	TextureView scene = Chain ? Chain->Run(Texture, Width, Height) : Texture.View();
+	Variants[Variant()]->Use();
 
 	// render texture quad
-	glActiveTexture(GL_TEXTURE0);
-	Texture.Bind();
-	glBindVertexArray(VAO);
+	GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	scene.Bind(0);
+	GLState::BindVertexArray(VAO);
 	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
+}
+
+PostProcessVariant PostProcessor::Variant() const
+{
+	unsigned int effect = Chaos ? POSTPROCESS_CHAOS : Confuse ? POSTPROCESS_CONFUSE : POSTPROCESS_NONE;
+	return static_cast<PostProcessVariant>(effect + (Shake ? 1 : 0));
 }
 
 void PostProcessor::initRenderData()
 {
-	unsigned int VBO;
 	float vertices[] = {
 		// pos        // tex
 		-1.0f, -1.0f, 0.0f, 0.0f,
@@ -112,15 +159,13 @@ void PostProcessor::initRenderData()
 	glGenVertexArrays(1, &VAO);
 	glGenBuffers(1, &VBO);
 
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 
-	glBindVertexArray(VAO);
+	GLState::BindVertexArray(VAO);
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
 
-	glBindBuffer(GL_ARRAY_BUFFER,0);
-	glBindVertexArray(0);
 }
 
 
@@ -1,33 +1,76 @@
 #pragma once
 #include "Shader.h"
 #include "Texture.h"
+#include "EffectChain.h"
+
+// one post-processing program per combination of effects that looks different; chaos overrides
+// confuse, so the shake bit is all that is combined with either
+enum PostProcessVariant
+{
+	POSTPROCESS_NONE,
+	POSTPROCESS_SHAKE,
+	POSTPROCESS_CONFUSE,
+	POSTPROCESS_CONFUSE_SHAKE,
+	POSTPROCESS_CHAOS,
+	POSTPROCESS_CHAOS_SHAKE,
+	POSTPROCESS_VARIANT_COUNT
+};
+
+// name a variant is loaded under and the #defines its shaders are compiled with
+struct PostProcessVariantInfo
+{
+	const char* Name;
+	std::vector<std::string> Defines;
+};
+
+// by PostProcessVariant
+extern const PostProcessVariantInfo POSTPROCESS_VARIANTS[POSTPROCESS_VARIANT_COUNT];
 
 class PostProcessor
 {
 public:
 	// state
-	Shader PostProcessingShader;
+	// the compiled variants, by PostProcessVariant; Render picks one instead of branching per pixel
+	Shader* Variants[POSTPROCESS_VARIANT_COUNT];
+	// owned, the resolved scene the effects read
 	Texture2D Texture;
 	unsigned int Width, Height;
 
 	bool Confuse, Chaos, Shake;
+	// not owned, null for none; run over the resolved scene every frame, the effects then read its result
+	EffectChain* Chain;
 
-	PostProcessor(Shader shader, unsigned int width, unsigned int height);
+	PostProcessor(Shader* const variants[POSTPROCESS_VARIANT_COUNT], unsigned int width, unsigned int height);
 	~PostProcessor();
 
+	PostProcessor(const PostProcessor&) = delete;
+	PostProcessor& operator=(const PostProcessor&) = delete;
+
 	// prepares the postprocessor's framebuffer operations before rending the game;
 	void BeginRender();
 
 	// should be called after the rendering the game, stores all rendered data into a texture;
+	// with no effect active and no chain the multisampled buffer is resolved straight into the default framebuffer
+	// instead, as long as that has the same format and size
 	void EndRender();
 
-	// renders the PostPrcessor texture quad(as a screen-encompassing large sprite)
-	void Render(float time);
+	// renders the PostPrcessor texture quad(as a screen-encompassing large sprite), the effects
+	// animate with the time in FrameData; does nothing when EndRender already resolved to the screen
+	void Render();
+
+	// the variant the current effect flags draw with
+	PostProcessVariant Variant() const;
+	// any of the effects is on, otherwise the scene needs no intermediate texture or quad pass
+	inline bool Active() const { return Confuse || Chaos || Shake; }
 private:
 	// render state
 	unsigned int MSFBO, FBO; // Multisampled FBO. FBo is regular framebuffer, used for blitting the MSColor buffer to the texture;
 	unsigned int RBO; // rbo is used for multisampled color buffer
-	unsigned int VAO;
+	unsigned int VAO, VBO;
+	// the default framebuffer has the multisampled buffer's format, so it can take the resolve itself
+	bool directResolve;
+	// EndRender resolved to the default framebuffer, so there is nothing left for Render to draw
+	bool bypassed;
 
 	// initialze quad for renndering postprocessing texture
 	void initRenderData();
@@ -0,0 +1,60 @@
+#include "pch.h"
+#include "RenderTargetPool.h"
+
+RenderTarget::RenderTarget(unsigned int width, unsigned int height, unsigned int wrap)
+	:FBO(0), Texture(), InUse(false)
+{
+	// the passes sample their inputs between texels and rely on Texture2D's linear filtering there
+	Texture.Wrap_S = wrap;
+	Texture.Wrap_T = wrap;
+	Texture.Generate(width, height, NULL);
+
+	glGenFramebuffers(1, &FBO);
+	glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, Texture.ID, 0);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		std::cout << "ERROR::RENDERTARGET: Failed to initialize " << width << "x" << height << " framebuffer" << std::endl;
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+RenderTarget::~RenderTarget()
+{
+	glDeleteFramebuffers(1, &FBO);
+}
+
+RenderTargetPool::RenderTargetPool()
+	:Created(0)
+{
+}
+
+RenderTargetPool::~RenderTargetPool()
+{
+	Clear();
+}
+
+RenderTarget& RenderTargetPool::Acquire(unsigned int width, unsigned int height, unsigned int wrap)
+{
+	for (RenderTarget& target : targets)
+	{
+		if (!target.InUse && target.Texture.Width == width && target.Texture.Height == height && target.Texture.Wrap_S == wrap)
+		{
+			target.InUse = true;
+			return target;
+		}
+	}
+
+	targets.emplace_back(width, height, wrap);
+	++Created;
+	targets.back().InUse = true;
+	return targets.back();
+}
+
+void RenderTargetPool::Release(RenderTarget& target)
+{
+	target.InUse = false;
+}
+
+void RenderTargetPool::Clear()
+{
+	targets.clear();
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <deque>
+#include "Texture.h"
+
+// a color texture and the framebuffer rendering into it
+struct RenderTarget
+{
+	unsigned int FBO;
+	Texture2D Texture;
+	// handed out by the pool and not yet released
+	bool InUse;
+
+	RenderTarget(unsigned int width, unsigned int height, unsigned int wrap);
+	~RenderTarget();
+
+	RenderTarget(const RenderTarget&) = delete;
+	RenderTarget& operator=(const RenderTarget&) = delete;
+};
+
+// Intermediate render targets shared by the passes of an EffectChain. A pass acquires its output and
+// releases its inputs once nothing later reads them, so a chain ping-pongs between a few targets of
+// each size instead of owning one per pass. Targets are created on first demand and kept for reuse.
+class RenderTargetPool
+{
+public:
+	RenderTargetPool();
+	~RenderTargetPool();
+
+	RenderTargetPool(const RenderTargetPool&) = delete;
+	RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+	// a free width x height target sampled with the given wrap mode, created if none is free
+	RenderTarget& Acquire(unsigned int width, unsigned int height, unsigned int wrap = GL_CLAMP_TO_EDGE);
+	void Release(RenderTarget& target);
+	// deletes every target, none may be in use anymore
+	void Clear();
+
+	// targets created since the pool was made, stays flat once the chains using it have run once
+	unsigned int Created;
+private:
+	// a deque so handed out references stay valid as the pool grows
+	std::deque<RenderTarget> targets;
+};
@@ -1,2 +0,0 @@
-#include "pch.h"
-#include "PowerUp.h"
@@ -5,86 +5,170 @@
 #include <stb_image/stb_image.h>
 
 // instantiate static variables
-std::map<std::string, Texture2D> ResourceManager::Textures;
-std::map<std::string, Shader>	 ResourceManager::Shaders;
+std::deque<Texture2D> ResourceManager::Textures;
+std::deque<Shader>    ResourceManager::Shaders;
+std::unordered_map<std::string, unsigned int> ResourceManager::textureIds;
+std::unordered_map<std::string, unsigned int> ResourceManager::shaderIds;
 
-Shader ResourceManager::LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name)
+// deepest #include nesting, anything beyond is taken for an include cycle
+static const unsigned int MAX_INCLUDE_DEPTH = 16;
+
+// source of a shader file with its #include lines expanded and, right after its #version line, a #define
+// for each of defines; #line directives keep the compiler's line numbers pointing into the file itself
+static bool preprocessShader(const std::string& file, const std::vector<std::string>& defines, unsigned int depth, std::string& source)
+{
+    std::ifstream stream(file);
+    if (!stream)
+    {
+        std::cout << "ERROR::SHADER: Failed to read shader file " << file << std::endl;
+        return false;
+    }
+    std::string directory = file.substr(0, file.find_last_of("/\\") + 1);
+
+    std::string line;
+    unsigned int number = 0;
+    while (std::getline(stream, line))
+    {
+        ++number;
+        size_t start = line.find_first_not_of(" \t");
+        if (start != std::string::npos && line.compare(start, 8, "#include") == 0)
+        {
+            size_t open = line.find('"', start), close = line.find('"', open + 1);
+            if (open == std::string::npos || close == std::string::npos)
+            {
+                std::cout << "ERROR::SHADER: Malformed #include in " << file << " line " << number << std::endl;
+                return false;
+            }
+            if (depth == MAX_INCLUDE_DEPTH)
+            {
+                std::cout << "ERROR::SHADER: #include nested too deep in " << file << std::endl;
+                return false;
+            }
+            if (!preprocessShader(directory + line.substr(open + 1, close - open - 1), std::vector<std::string>(), depth + 1, source))
+                return false;
+            source += "#line " + std::to_string(number + 1) + "\n";
+            continue;
+        }
+
+        source += line;
+        source += '\n';
+        if (start != std::string::npos && line.compare(start, 8, "#version") == 0 && !defines.empty())
+        {
+            for (const std::string& define : defines)
+                source += "#define " + define + "\n";
+            source += "#line " + std::to_string(number + 1) + "\n";
+        }
+    }
+    return true;
+}
+
+// id of an interned name, or the next free one (count) after interning it
+static unsigned int intern(std::unordered_map<std::string, unsigned int>& ids, const std::string& name, size_t count)
 {
-    Shaders[name] = loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile);
-    return Shaders[name];
+    return ids.emplace(name, static_cast<unsigned int>(count)).first->second;
 }
 
-Shader ResourceManager::GetShader(std::string name)
+ShaderHandle ResourceManager::LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, const std::string& name,
+    const std::vector<std::string>& defines)
 {
-    return Shaders[name];
+    return AddShader(loadShaderFromFile(vShaderFile, fShaderFile, gShaderFile, defines), name);
 }
 
-Texture2D ResourceManager::LoadTexture(const char* file, bool alpha, std::string name)
+ShaderHandle ResourceManager::AddShader(Shader&& shader, const std::string& name)
 {
-    Textures[name] = loadTextureFromFile(file, alpha);
-    return Textures[name];
+    ShaderHandle handle;
+    handle.Index = intern(shaderIds, name, Shaders.size());
+    if (handle.Index == Shaders.size())
+        Shaders.push_back(std::move(shader));
+    else
+        Shaders[handle.Index] = std::move(shader);
+    return handle;
 }
 
-Texture2D ResourceManager::GetTexture(std::string name)
+ShaderHandle ResourceManager::FindShader(const std::string& name)
 {
-    return Textures[name];
+    ShaderHandle handle;
+    auto found = shaderIds.find(name);
+    if (found != shaderIds.end())
+        handle.Index = found->second;
+    return handle;
 }
 
-void ResourceManager::Clear()
+Shader& ResourceManager::GetShader(const std::string& name)
 {
-    //properly delete all shaders
-    for (auto iter : Shaders)
-    {
-        glDeleteProgram(iter.second.ID);
-    }
+    ShaderHandle handle = FindShader(name);
+    if (handle.Valid())
+        return Shaders[handle.Index];
+    std::cout << "ERROR::RESOURCEMANAGER: No shader named " << name << std::endl;
+    static Shader missing;
+    return missing;
+}
 
-    //properly delete all textures
-    for (auto iter : Textures)
-    {
-        glDeleteTextures(1, &iter.second.ID);
-    }
+TextureHandle ResourceManager::LoadTexture(const char* file, bool alpha, const std::string& name)
+{
+    return AddTexture(loadTextureFromFile(file, alpha), name);
+}
+
+TextureHandle ResourceManager::AddTexture(Texture2D&& texture, const std::string& name)
+{
+    TextureHandle handle;
+    handle.Index = intern(textureIds, name, Textures.size());
+    if (handle.Index == Textures.size())
+        Textures.push_back(std::move(texture));
+    else
+        Textures[handle.Index] = std::move(texture);
+    return handle;
+}
+
+TextureHandle ResourceManager::FindTexture(const std::string& name)
+{
+    TextureHandle handle;
+    auto found = textureIds.find(name);
+    if (found != textureIds.end())
+        handle.Index = found->second;
+    return handle;
+}
+
+Texture2D& ResourceManager::GetTexture(const std::string& name)
+{
+    TextureHandle handle = FindTexture(name);
+    if (handle.Valid())
+        return Textures[handle.Index];
+    std::cout << "ERROR::RESOURCEMANAGER: No texture named " << name << std::endl;
+    static Texture2D missing;
+    return missing;
 }
 
-Shader ResourceManager::loadShaderFromFile(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile)
+void ResourceManager::Clear()
 {
-    // 1. retrieve the vertex/fragment source code from filePath
+    // shaders and textures delete their GL objects themselves
+    Shaders.clear();
+    Textures.clear();
+    shaderIds.clear();
+    textureIds.clear();
+}
+
+Shader ResourceManager::loadShaderFromFile(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, const std::vector<std::string>& defines)
+{
+    // 1. retrieve the vertex/fragment source code from filePath, with includes and defines resolved
     std::string vertexCode;
     std::string fragmentCode;
     std::string geometryCode;
-    try
-    {
-        // open files
-        std::ifstream vertexShaderFile(vShaderFile);
-        std::ifstream fragmentShaderFile(fShaderFile);
-        std::stringstream vShaderStream, fShaderStream;
-        // read file's buffer contents into streams
-        vShaderStream << vertexShaderFile.rdbuf();
-        fShaderStream << fragmentShaderFile.rdbuf();
-        // close file handlers
-        vertexShaderFile.close();
-        fragmentShaderFile.close();
-        // convert stream into string
-        vertexCode = vShaderStream.str();
-        fragmentCode = fShaderStream.str();
-        // if geometry shader path is present, also load a geometry shader
-        if (gShaderFile != nullptr)
-        {
-            std::ifstream geometryShaderFile(gShaderFile);
-            std::stringstream gShaderStream;
-            gShaderStream << geometryShaderFile.rdbuf();
-            geometryShaderFile.close();
-            geometryCode = gShaderStream.str();
-        }
-    }
-    catch (std::exception e)
+    // if geometry shader path is present, also load a geometry shader
+    bool read = preprocessShader(vShaderFile, defines, 0, vertexCode)
+        && preprocessShader(fShaderFile, defines, 0, fragmentCode)
+        && (gShaderFile == nullptr || preprocessShader(gShaderFile, defines, 0, geometryCode));
+    Shader shader;
+    // a truncated source would only fail to compile far from the cause, the program stays empty instead
+    if (!read)
     {
-        std::cout << "ERROR::SHADER: Failed to read shader files" << std::endl;
+        std::cout << "ERROR::SHADER: Not compiling " << vShaderFile << " / " << fShaderFile << ", a source could not be read" << std::endl;
+        return shader;
     }
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
     const char* gShaderCode = geometryCode.c_str();
     // 2. now create shader object from source code
-    Shader shader;
     shader.Compile(vShaderCode, fShaderCode, gShaderFile != nullptr ? gShaderCode : nullptr);
     return shader;
 }
@@ -1,32 +1,67 @@
 #pragma once
+#include <deque>
 #include <Shader.h>
 #include <Texture.h>
+
+// Small integer naming a loaded resource. Names are interned once when a resource is loaded;
+// from then on a handle is a plain index into the dense resource arrays.
+struct ShaderHandle
+{
+	unsigned int Index = ~0u;
+	inline bool Valid() const { return Index != ~0u; }
+};
+
+struct TextureHandle
+{
+	unsigned int Index = ~0u;
+	inline bool Valid() const { return Index != ~0u; }
+};
+
 class ResourceManager
 {
 public:
-	static std::map<std::string, Shader> Shaders;
-	static std::map<std::string, Texture2D> Textures;
+	// indexed by handle and owning every loaded resource; a deque never moves its elements,
+	// so references handed out stay valid across later loads, until Clear
+	static std::deque<Shader> Shaders;
+	static std::deque<Texture2D> Textures;
+
+	// loading under a name that is taken replaces that resource, existing handles then see the new one;
+	// every stage is compiled with a #define for each of defines, and #include "file" lines are
+	// replaced by that file, relative to the including one
+	static ShaderHandle LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, const std::string& name,
+		const std::vector<std::string>& defines = std::vector<std::string>());
+	static ShaderHandle AddShader(Shader&& shader, const std::string& name);
 
-	static Shader LoadShader(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, std::string name);
+	// handle of a loaded shader, invalid if there is none by that name
+	static ShaderHandle FindShader(const std::string& name);
 
 	//retrives a stored shader
-	static Shader GetShader(std::string name);
+	static inline Shader& GetShader(ShaderHandle handle) { return Shaders[handle.Index]; }
+	// by name, for load time; reports a missing shader and hands back an empty one
+	static Shader& GetShader(const std::string& name);
 
 	//loads (and generates) a texture from a file
-	static Texture2D LoadTexture(const char* file, bool alpha, std::string name);
+	static TextureHandle LoadTexture(const char* file, bool alpha, const std::string& name);
+	static TextureHandle AddTexture(Texture2D&& texture, const std::string& name);
+
+	static TextureHandle FindTexture(const std::string& name);
 
 	//retreves a stored texture
-	static Texture2D GetTexture(std::string name);
+	static inline Texture2D& GetTexture(TextureHandle handle) { return Textures[handle.Index]; }
+	static Texture2D& GetTexture(const std::string& name);
 
-	//proeprly de-allocates all loaded resources
+	//proeprly de-allocates all loaded resources, every handle is invalid afterwards; needs the GL context still current
 	static void Clear();
 
 private:
+	// interned names, only touched when loading or looking up by name
+	static std::unordered_map<std::string, unsigned int> shaderIds, textureIds;
+
 	//private constructor because we do not actually want resource manager objects. Its members and functions should be publicly available(static).
 	ResourceManager();
 
-	//loads and generates a shader from a file
-	static Shader loadShaderFromFile(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile = nullptr);
+	//loads and generates a shader from a file, left empty (ID 0) if a source or one of its includes cannot be read
+	static Shader loadShaderFromFile(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile, const std::vector<std::string>& defines);
 
 	//loads a single texture from a file
 	static Texture2D loadTextureFromFile(const char* file, bool alpha);
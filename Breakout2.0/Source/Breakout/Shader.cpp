@@ -1,7 +1,10 @@
 #include "pch.h"
 #include "Shader.h"
+#include "FrameData.h"
+#include "GLState.h"
 
 #include<iostream>
+#include <cstring>
 #include <glm/gtc/type_ptr.hpp>
 
 
@@ -10,11 +13,32 @@ Shader::Shader()
 
 Shader::~Shader()
 {
+	if (this->ID != 0)
+		GLState::DeleteProgram(this->ID);
+}
+
+Shader::Shader(Shader&& other) noexcept
+	:ID(other.ID), uniforms(std::move(other.uniforms))
+{
+	other.ID = 0;
+}
+
+Shader& Shader::operator=(Shader&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (this->ID != 0)
+			GLState::DeleteProgram(this->ID);
+		ID = other.ID;
+		uniforms = std::move(other.uniforms);
+		other.ID = 0;
+	}
+	return *this;
 }
 
 Shader& Shader::Use()
 {
-	glUseProgram(this->ID);
+	GLState::UseProgram(this->ID);
 	return *this;
 }
 
@@ -39,7 +63,9 @@ void Shader::Compile(const char* vertexSource, const char* fragmentSource, const
 		glCompileShader(gShader);
 		checkCompileErrors(gShader, "GEOMETRY");
 	}
-	// shader program
+	// shader program, replacing any this object already owned
+	if (this->ID != 0)
+		GLState::DeleteProgram(this->ID);
 	this->ID = glCreateProgram();
 	glAttachShader(this->ID, sVertex);
 	glAttachShader(this->ID, sFragment);
@@ -47,6 +73,7 @@ void Shader::Compile(const char* vertexSource, const char* fragmentSource, const
 		glAttachShader(this->ID, gShader);
 	glLinkProgram(this->ID);
 	checkCompileErrors(this->ID, "PROGRAM");
+	reflect();
 	// delete the shaders as they're linked into our program now and no longer necessary
 	glDeleteShader(sVertex);
 	glDeleteShader(sFragment);
@@ -54,59 +81,96 @@ void Shader::Compile(const char* vertexSource, const char* fragmentSource, const
 		glDeleteShader(gShader);
 }
 
+int Shader::Location(const char* name) const
+{
+	for (const auto& uniform : uniforms)
+		if (std::strcmp(uniform.first.c_str(), name) == 0)
+			return uniform.second;
+	return -1;
+}
+
+void Shader::Set(Uniform<float> uniform, float value)
+{
+	glUniform1f(uniform.Location, value);
+}
+void Shader::Set(Uniform<int> uniform, int value)
+{
+	glUniform1i(uniform.Location, value);
+}
+void Shader::Set(Uniform<bool> uniform, bool value)
+{
+	glUniform1i(uniform.Location, value);
+}
+void Shader::Set(Uniform<glm::vec2> uniform, const glm::vec2& value)
+{
+	glUniform2f(uniform.Location, value.x, value.y);
+}
+void Shader::Set(Uniform<glm::vec3> uniform, const glm::vec3& value)
+{
+	glUniform3f(uniform.Location, value.x, value.y, value.z);
+}
+void Shader::Set(Uniform<glm::vec4> uniform, const glm::vec4& value)
+{
+	glUniform4f(uniform.Location, value.x, value.y, value.z, value.w);
+}
+void Shader::Set(Uniform<glm::mat4> uniform, const glm::mat4& value)
+{
+	glUniformMatrix4fv(uniform.Location, 1, false, glm::value_ptr(value));
+}
+
 void Shader::SetFloat(const char* name, float value, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform1f(glGetUniformLocation(this->ID, name), value);
+	glUniform1f(Location(name), value);
 }
 void Shader::SetInteger(const char* name, int value, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform1i(glGetUniformLocation(this->ID, name), value);
+	glUniform1i(Location(name), value);
 }
 void Shader::SetVector2f(const char* name, float x, float y, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform2f(glGetUniformLocation(this->ID, name), x, y);
+	glUniform2f(Location(name), x, y);
 }
 void Shader::SetVector2f(const char* name, const glm::vec2& value, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform2f(glGetUniformLocation(this->ID, name), value.x, value.y);
+	glUniform2f(Location(name), value.x, value.y);
 }
 void Shader::SetVector3f(const char* name, float x, float y, float z, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform3f(glGetUniformLocation(this->ID, name), x, y, z);
+	glUniform3f(Location(name), x, y, z);
 }
 void Shader::SetVector3f(const char* name, const glm::vec3& value, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform3f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z);
+	glUniform3f(Location(name), value.x, value.y, value.z);
 }
 void Shader::SetVector4f(const char* name, float x, float y, float z, float w, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform4f(glGetUniformLocation(this->ID, name), x, y, z, w);
+	glUniform4f(Location(name), x, y, z, w);
 }
 void Shader::SetVector4f(const char* name, const glm::vec4& value, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniform4f(glGetUniformLocation(this->ID, name), value.x, value.y, value.z, value.w);
+	glUniform4f(Location(name), value.x, value.y, value.z, value.w);
 }
 void Shader::SetMatrix4(const char* name, const glm::mat4& matrix, bool useShader)
 {
 	if (useShader)
 		this->Use();
-	glUniformMatrix4fv(glGetUniformLocation(this->ID, name), 1, false, glm::value_ptr(matrix));
+	glUniformMatrix4fv(Location(name), 1, false, glm::value_ptr(matrix));
 }
 
 void Shader::checkCompileErrors(unsigned int object, std::string type)
@@ -138,6 +202,30 @@ void Shader::checkCompileErrors(unsigned int object, std::string type)
 	}
 }
 
+void Shader::reflect()
+{
+	uniforms.clear();
+	int count = 0, maxLength = 0;
+	glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+	std::vector<char> name(std::max(maxLength, 1));
+	for (int i = 0; i < count; ++i)
+	{
+		int size;
+		unsigned int type;
+		glGetActiveUniform(this->ID, i, static_cast<int>(name.size()), nullptr, &size, &type, name.data());
+		int location = glGetUniformLocation(this->ID, name.data());
+		if (location < 0)
+			continue;
+		// arrays are reported as "name[0]", the location of that is the array's
+		std::string key = name.data();
+		size_t bracket = key.find('[');
+		if (bracket != std::string::npos)
+			key.resize(bracket);
+		uniforms.emplace_back(key, location);
+	}
 
-
-
+	unsigned int frameData = glGetUniformBlockIndex(this->ID, "FrameData");
+	if (frameData != GL_INVALID_INDEX)
+		glUniformBlockBinding(this->ID, frameData, FRAME_DATA_BINDING);
+}
@@ -1,4 +1,15 @@
 #pragma once
+
+// location of a uniform of type T in one shader program, resolved once; setting a uniform
+// through it does no name lookup at all
+template<typename T>
+struct Uniform
+{
+	int Location = -1;
+};
+
+// Owns its GL program, deleted with the object. Move-only: renderers keep a reference to the
+// shader the ResourceManager holds instead of a copy of its program id.
 class Shader
 {
 public:
@@ -7,10 +18,30 @@ public:
 	Shader();
 	~Shader();
 
+	Shader(const Shader&) = delete;
+	Shader& operator=(const Shader&) = delete;
+	Shader(Shader&& other) noexcept;
+	Shader& operator=(Shader&& other) noexcept;
+
 	// compiles the shader frmo given source code
 	void Compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource = nullptr); //note: gemotery source is optional
 
 	Shader& Use();
+
+	// location of a uniform (arrays by their plain name) from the table built at link time, -1 if the
+	// program has none by that name; uniforms inside blocks like FrameData have no location
+	int Location(const char* name) const;
+	template<typename T>
+	inline Uniform<T> GetUniform(const char* name) const { Uniform<T> uniform; uniform.Location = Location(name); return uniform; }
+
+	// set on the shader in use, like the utility functions below without useShader
+	void    Set(Uniform<float> uniform, float value);
+	void    Set(Uniform<int> uniform, int value);
+	void    Set(Uniform<bool> uniform, bool value);
+	void    Set(Uniform<glm::vec2> uniform, const glm::vec2& value);
+	void    Set(Uniform<glm::vec3> uniform, const glm::vec3& value);
+	void    Set(Uniform<glm::vec4> uniform, const glm::vec4& value);
+	void    Set(Uniform<glm::mat4> uniform, const glm::mat4& value);
 public:
 	//utlity functions
 	void    SetFloat(const char* name, float value, bool useShader = false);
@@ -23,6 +54,11 @@ public:
 	void    SetVector4f(const char* name, const glm::vec4& value, bool useShader = false);
 	void    SetMatrix4(const char* name, const glm::mat4& matrix, bool useShader = false);
 private:
+	// active uniforms and their locations, few enough that a linear scan beats hashing the name
+	std::vector<std::pair<std::string, int>> uniforms;
+
 	void checkCompileErrors(unsigned int object, std::string type);
+	// fills uniforms and binds the FrameData block, right after linking
+	void reflect();
 };
 
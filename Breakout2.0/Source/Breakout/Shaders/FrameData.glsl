@@ -0,0 +1,6 @@
+// shared by every shader, uploaded once per frame (FrameData.h)
+layout (std140) uniform FrameData
+{
+	mat4 projection;
+	float time;
+};
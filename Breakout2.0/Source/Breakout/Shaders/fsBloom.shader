@@ -0,0 +1,13 @@
+#version 330 core
+// adds the blurred bright parts back onto the scene
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D scene;
+uniform sampler2D bloom;
+uniform float intensity;
+
+void main()
+{
+	color = vec4(texture(scene, TexCoords).rgb + texture(bloom, TexCoords).rgb * intensity, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#version 330 core
+// one direction of a separable Gaussian blur, the kernel comes from GaussianKernel: a center tap and
+// taps - 1 more mirrored on both sides, offsets in texels along texelStep
+in vec2 TexCoords;
+out vec4 color;
+
+// MAX_BLUR_TAPS in Bloom.h
+const int MAX_TAPS = 16;
+
+uniform sampler2D image;
+uniform vec2 texelStep;
+uniform int taps;
+uniform float weights[MAX_TAPS];
+uniform float offsets[MAX_TAPS];
+
+void main()
+{
+	vec3 sum = texture(image, TexCoords).rgb * weights[0];
+	for (int i = 1; i < taps; i++)
+	{
+		vec2 offset = texelStep * offsets[i];
+		sum += texture(image, TexCoords + offset).rgb * weights[i];
+		sum += texture(image, TexCoords - offset).rgb * weights[i];
+	}
+	color = vec4(sum, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#version 330 core
+
+in vec2 TexCoords;
+in vec3 BrickColor;
+flat in float Solid;
+out vec4 color;
+
+uniform sampler2D block;
+uniform sampler2D blockSolid;
+
+void main()
+{
+	vec4 texel = Solid > 0.5 ? texture(blockSolid, TexCoords) : texture(block, TexCoords);
+	color = vec4(BrickColor, 1.0) * texel;
+}
@@ -0,0 +1,13 @@
+#version 330 core
+// keeps what is brighter than threshold, rescaled to the full range
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D image;
+uniform float threshold;
+
+void main()
+{
+	vec3 scene = texture(image, TexCoords).rgb;
+	color = vec4(max(scene - vec3(threshold), 0.0) / (1.0 - threshold), 1.0);
+}
\ No newline at end of file
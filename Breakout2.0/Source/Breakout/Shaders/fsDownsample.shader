@@ -0,0 +1,12 @@
+#version 330 core
+// at half the input's resolution every pixel center lies between four input texels, so one
+// filtered fetch is their average
+in vec2 TexCoords;
+out vec4 color;
+
+uniform sampler2D image;
+
+void main()
+{
+	color = vec4(texture(image, TexCoords).rgb, 1.0);
+}
\ No newline at end of file
@@ -1,46 +1,34 @@
 #version 330 core
+// compiled once per combination of CHAOS, CONFUSE and SHAKE, chaos wins over confuse and both over shake
 in vec2 TexCoords;
 out vec4 color;
 
 uniform sampler2D scene;
+#if defined(CHAOS) || defined(SHAKE)
 uniform vec2    offsets[9];
+#endif
+#if defined(CHAOS)
 uniform int     edge_kernel[9];
+#elif defined(SHAKE) && !defined(CONFUSE)
 uniform float  blur_kernel[9];
-
-uniform bool chaos;
-uniform bool confuse;
-uniform bool shake;
+#endif
 
 void main()
 {
+#if defined(CHAOS)
     // zero out memory since an out variable is initialized with undefined values by default 
     color = vec4(0.0f);
-
-    vec3 sample[9];
-    // sample from texture offsets if using convolution matrix
-    if (chaos || shake)
-        for (int i = 0; i < 9; i++)
-            sample[i] = vec3(texture(scene, TexCoords.st + offsets[i]));
-
-    // process effects
-    if (chaos)
-    {
-        for (int i = 0; i < 9; i++)
-            color += vec4(sample[i] * edge_kernel[i], 0.0f);
-        color.a = 1.0f;
-    }
-    else if (confuse)
-    {
-        color = vec4(1.0 - texture(scene, TexCoords).rgb, 1.0);
-    }
-    else if (shake)
-    {
-        for (int i = 0; i < 9; i++)
-            color += vec4(sample[i] * blur_kernel[i], 0.0f);
-        color.a = 1.0f;
-    }
-    else
-    {
-        color = texture(scene, TexCoords);
-    }
+    for (int i = 0; i < 9; i++)
+        color += vec4(vec3(texture(scene, TexCoords.st + offsets[i])) * edge_kernel[i], 0.0f);
+    color.a = 1.0f;
+#elif defined(CONFUSE)
+    color = vec4(1.0 - texture(scene, TexCoords).rgb, 1.0);
+#elif defined(SHAKE)
+    color = vec4(0.0f);
+    for (int i = 0; i < 9; i++)
+        color += vec4(vec3(texture(scene, TexCoords.st + offsets[i])) * blur_kernel[i], 0.0f);
+    color.a = 1.0f;
+#else
+    color = texture(scene, TexCoords);
+#endif
 }
\ No newline at end of file
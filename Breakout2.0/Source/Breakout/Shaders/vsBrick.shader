@@ -0,0 +1,23 @@
+#version 330 core
+layout(location = 0) in vec2 vertex;
+layout(location = 1) in vec4 rect; // position, size
+layout(location = 2) in vec3 color;
+layout(location = 3) in vec2 state; // solid, alive
+
+out vec2 TexCoords;
+out vec3 BrickColor;
+flat out float Solid;
+
+#include "FrameData.glsl"
+
+void main()
+{
+	TexCoords = vertex;
+	BrickColor = color;
+	Solid = state.x;
+	// destroyed bricks collapse onto a point outside the clip volume
+	if (state.y == 0.0)
+		gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+	else
+		gl_Position = projection * vec4(rect.xy + vertex * rect.zw, 0.0, 1.0);
+}
@@ -0,0 +1,11 @@
+#version 330 core
+// full screen quad of an EffectChain pass
+layout(location = 0) in vec4 vertex; // <vec2 position, vec2 texCoords>
+
+out vec2 TexCoords;
+
+void main()
+{
+	gl_Position = vec4(vertex.xy, 0.0, 1.0);
+	TexCoords = vertex.zw;
+}
\ No newline at end of file
@@ -1,18 +1,20 @@
 #version 330 core
 layout (location = 0) in vec4 vertex;
+// per particle, one instance each
+layout (location = 1) in vec2 offset;
+layout (location = 2) in vec3 color;
+layout (location = 3) in float alpha;
 
 out vec2 TexCoords;
 out vec4 ParticleColor;
 
-uniform mat4 projection;
-uniform vec2 offset;
-uniform vec4 color;
+#include "FrameData.glsl"
 
 
 void main()
 {
 	float scale = 10.0f;
 	TexCoords = vertex.zw;
-	ParticleColor = color;
+	ParticleColor = vec4(color, alpha);
 	gl_Position = projection * vec4((vertex.xy * scale) + offset, 0.0, 1.0);
 }
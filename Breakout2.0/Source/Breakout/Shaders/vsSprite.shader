@@ -4,7 +4,7 @@ layout(location = 0) in vec4 vertex;
 out vec2 TexCoords;
 
 uniform mat4 model;
-uniform mat4 projection;
+#include "FrameData.glsl"
 
 void main()
 {
@@ -0,0 +1,15 @@
+#version 330 core
+layout(location = 0) in vec4 vertex;
+layout(location = 1) in vec3 color;
+
+out vec2 TexCoords;
+out vec3 SpriteColor;
+
+#include "FrameData.glsl"
+
+void main()
+{
+	TexCoords = vertex.zw;
+	SpriteColor = color;
+	gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
+}
@@ -0,0 +1,122 @@
+#include "pch.h"
+#include "GLState.h"
+#include "SpriteBatch.h"
+
+SpriteBatch::SpriteBatch(Shader& shader, unsigned int maxSprites)
+	:DrawCalls(0), Sprites(0), shader(shader), maxSprites(maxSprites), texture(0)
+{
+	vertices.reserve(maxSprites * 4);
+	initRenderData();
+}
+
+SpriteBatch::~SpriteBatch()
+{
+	GLState::DeleteVertexArray(VAO);
+	GLState::DeleteBuffer(VBO);
+	GLState::DeleteBuffer(EBO);
+}
+
+void SpriteBatch::Begin()
+{
+	vertices.clear();
+	texture = 0;
+}
+
+void SpriteBatch::DrawSprite(TextureView sprite, glm::vec2 position, glm::vec2 size, float rotate, glm::vec3 color)
+{
+	if (sprite.ID != texture || vertices.size() == maxSprites * 4)
+	{
+		flush();
+		texture = sprite.ID;
+	}
+
+	// same corners SpriteRenderer's model matrix produces: rotated around the sprite's center
+	glm::vec2 corners[4] = {
+		glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 0.0f),
+		glm::vec2(1.0f, 1.0f), glm::vec2(0.0f, 1.0f)
+	};
+	if (rotate == 0.0f)
+	{
+		for (glm::vec2& corner : corners)
+			corner = position + corner * size;
+	}
+	else
+	{
+		float angle = glm::radians(rotate);
+		float c = std::cos(angle), s = std::sin(angle);
+		glm::vec2 center = position + 0.5f * size;
+		for (glm::vec2& corner : corners)
+		{
+			glm::vec2 local = (corner - 0.5f) * size;
+			corner = center + glm::vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+		}
+	}
+
+	vertices.push_back({ corners[0], glm::vec2(0.0f, 0.0f), color });
+	vertices.push_back({ corners[1], glm::vec2(1.0f, 0.0f), color });
+	vertices.push_back({ corners[2], glm::vec2(1.0f, 1.0f), color });
+	vertices.push_back({ corners[3], glm::vec2(0.0f, 1.0f), color });
+	++Sprites;
+}
+
+void SpriteBatch::End()
+{
+	flush();
+}
+
+void SpriteBatch::ResetStats()
+{
+	DrawCalls = 0;
+	Sprites = 0;
+}
+
+void SpriteBatch::flush()
+{
+	if (vertices.empty())
+		return;
+
+	shader.Use();
+	GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	GLState::BindTexture(0, texture);
+
+	GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
+	// orphan the old storage so the driver does not wait on the previous flush still reading it
+	glBufferData(GL_ARRAY_BUFFER, maxSprites * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+
+	GLState::BindVertexArray(VAO);
+	glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(vertices.size() / 4 * 6), GL_UNSIGNED_INT, (void*)0);
+
+	++DrawCalls;
+	vertices.clear();
+}
+
+void SpriteBatch::initRenderData()
+{
+	// every sprite is the same two triangles over its four vertices, split along the same
+	// diagonal as SpriteRenderer's quad so both rasterize identically
+	std::vector<unsigned int> indices(maxSprites * 6);
+	for (unsigned int i = 0; i < maxSprites; ++i)
+	{
+		unsigned int first = i * 4;
+		unsigned int quad[6] = { first + 3, first + 1, first, first + 3, first + 2, first + 1 };
+		std::copy(quad, quad + 6, indices.begin() + i * 6);
+	}
+
+	glGenVertexArrays(1, &VAO);
+	glGenBuffers(1, &VBO);
+	glGenBuffers(1, &EBO);
+	GLState::BindVertexArray(VAO);
+
+	GLState::BindBuffer(GL_ARRAY_BUFFER, VBO);
+	glBufferData(GL_ARRAY_BUFFER, maxSprites * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+
+	// position and tex coords sit next to each other and are read as one vec4, like the sprite shader's vertex
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Color));
+
+}
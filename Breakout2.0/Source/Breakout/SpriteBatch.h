@@ -0,0 +1,44 @@
+#pragma once
+#include <Shader.h>
+#include <Texture.h>
+
+// Collects sprites into one dynamic vertex buffer and draws them with a single call per texture.
+// Sprites are transformed on the CPU, so the shader (vsSpriteBatch/fsSpriteBatch) only needs the
+// projection. Draw order is kept, a flush happens whenever the texture changes or the buffer is full.
+class SpriteBatch
+{
+public:
+	SpriteBatch(Shader& shader, unsigned int maxSprites = 1024);
+	~SpriteBatch();
+
+	SpriteBatch(const SpriteBatch&) = delete;
+	SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+	void Begin();
+	void DrawSprite(TextureView texture, glm::vec2 position,
+				glm::vec2 size = glm::vec2(10.0f, 10.0f), float rotate = 0.0f,
+				glm::vec3 color = glm::vec3(1.0f));
+	// draws whatever is still queued
+	void End();
+
+	// counters since the last ResetStats, to check how well a frame batches
+	unsigned int DrawCalls, Sprites;
+	void ResetStats();
+private:
+	struct Vertex
+	{
+		glm::vec2 Position;
+		glm::vec2 TexCoords;
+		glm::vec3 Color;
+	};
+
+	Shader& shader;
+	unsigned int maxSprites;
+	unsigned int VAO, VBO, EBO;
+
+	std::vector<Vertex> vertices;
+	unsigned int texture;
+
+	void flush();
+	void initRenderData();
+};
@@ -1,17 +1,20 @@
 #include "pch.h"
+#include "GLState.h"
 #include "SpriteRenderer.h"
 
-SpriteRenderer::SpriteRenderer(Shader shader)
-	:shader(shader)
+SpriteRenderer::SpriteRenderer(Shader& shader)
+	:shader(shader), modelUniform(shader.GetUniform<glm::mat4>("model")), colorUniform(shader.GetUniform<glm::vec3>("spriteColor"))
 {
 	initRenderData();
 }
 
 SpriteRenderer::~SpriteRenderer()
 {
+	GLState::DeleteVertexArray(quadVAO);
+	GLState::DeleteBuffer(quadVBO);
 }
 
-void SpriteRenderer::DrawSprite(const Texture2D& texture, glm::vec2 position, glm::vec2 size, float rotate, glm::vec3 color)
+void SpriteRenderer::DrawSprite(TextureView texture, glm::vec2 position, glm::vec2 size, float rotate, glm::vec3 color)
 {
 	shader.Use();
 	glm::mat4 model = glm::mat4(1.0f);
@@ -21,21 +24,19 @@ void SpriteRenderer::DrawSprite(const Texture2D& texture, glm::vec2 position, gl
 	model = glm::translate(model, glm::vec3(-0.5 * size.x, -0.5 * size.y, 0.0));
 	model = glm::scale(model, glm::vec3(size, 1.0f));
 
-	shader.SetMatrix4("model", model);
-	shader.SetVector3f("spriteColor", color);
+	shader.Set(modelUniform, model);
+	shader.Set(colorUniform, color);
 
-	glActiveTexture(GL_TEXTURE0);
-	texture.Bind();
+	GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	texture.Bind(0);
 
-	glBindVertexArray(quadVAO);
+	GLState::BindVertexArray(quadVAO);
 	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
 }
 
 void SpriteRenderer::initRenderData()
 {
 	// configure VAO/VBO
-	unsigned int VBO;
 	float vertices[] = {
 		// pos // tex
 		0.0f, 1.0f, 0.0f, 1.0f,
@@ -46,16 +47,14 @@ void SpriteRenderer::initRenderData()
 		1.0f, 0.0f, 1.0f, 0.0f
 	};
 	glGenVertexArrays(1, &quadVAO);
-	glGenBuffers(1, &VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
+	glGenBuffers(1, &quadVBO);
+	GLState::BindBuffer(GL_ARRAY_BUFFER, quadVBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices,
 		GL_STATIC_DRAW);
-	glBindVertexArray(quadVAO);
+	GLState::BindVertexArray(quadVAO);
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float),
 		(void*)0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
 }
 
 
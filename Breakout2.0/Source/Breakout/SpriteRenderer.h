@@ -5,16 +5,21 @@
 class SpriteRenderer
 {
 public:
-	SpriteRenderer(Shader shader);
+	SpriteRenderer(Shader& shader);
 	~SpriteRenderer();
 
-	void DrawSprite(const Texture2D& texture, glm::vec2 position,
+	SpriteRenderer(const SpriteRenderer&) = delete;
+	SpriteRenderer& operator=(const SpriteRenderer&) = delete;
+
+	void DrawSprite(TextureView texture, glm::vec2 position,
 				glm::vec2 size = glm::vec2(10.0f,10.0f), float rotate = 0.0f,
 				glm::vec3 color = glm::vec3(1.0f));
 
 private:
-	Shader shader;
-	unsigned int quadVAO;
+	Shader& shader;
+	Uniform<glm::mat4> modelUniform;
+	Uniform<glm::vec3> colorUniform;
+	unsigned int quadVAO, quadVBO;
 
 	void initRenderData();
 };
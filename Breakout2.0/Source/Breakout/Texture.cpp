@@ -1,10 +1,49 @@
 #include "pch.h"
 #include "Texture.h"
+#include "GLState.h"
 
+void TextureView::Bind(unsigned int unit) const
+{
+	GLState::BindTexture(unit, this->ID);
+}
+
+// no GL call here, a default constructed texture is free until it is generated
 Texture2D::Texture2D()
-	:Width(0), Height(0), Internal_Format(GL_RGB), Image_Format(GL_RGB), Wrap_S(GL_REPEAT), Wrap_T(GL_REPEAT), Filter_Min(GL_LINEAR), Filter_Max(GL_LINEAR)
+	:ID(0), Width(0), Height(0), Internal_Format(GL_RGB), Image_Format(GL_RGB), Wrap_S(GL_REPEAT), Wrap_T(GL_REPEAT), Filter_Min(GL_LINEAR), Filter_Max(GL_LINEAR)
+{
+}
+
+Texture2D::~Texture2D()
+{
+	if (this->ID != 0)
+		GLState::DeleteTexture(this->ID);
+}
+
+Texture2D::Texture2D(Texture2D&& other) noexcept
+	:ID(other.ID), Width(other.Width), Height(other.Height), Internal_Format(other.Internal_Format), Image_Format(other.Image_Format),
+	Wrap_S(other.Wrap_S), Wrap_T(other.Wrap_T), Filter_Min(other.Filter_Min), Filter_Max(other.Filter_Max)
 {
-	glGenTextures(1, &this->ID);
+	other.ID = 0;
+}
+
+Texture2D& Texture2D::operator=(Texture2D&& other) noexcept
+{
+	if (this != &other)
+	{
+		if (this->ID != 0)
+			GLState::DeleteTexture(this->ID);
+		ID = other.ID;
+		Width = other.Width;
+		Height = other.Height;
+		Internal_Format = other.Internal_Format;
+		Image_Format = other.Image_Format;
+		Wrap_S = other.Wrap_S;
+		Wrap_T = other.Wrap_T;
+		Filter_Min = other.Filter_Min;
+		Filter_Max = other.Filter_Max;
+		other.ID = 0;
+	}
+	return *this;
 }
 
 void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char* data)
@@ -12,8 +51,11 @@ void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char*
 	this->Width = width;
 	this->Height = height;
 
+	if (this->ID == 0)
+		glGenTextures(1, &this->ID);
+
 	//create Texture
-	glBindTexture(GL_TEXTURE_2D, this->ID);
+	GLState::BindTexture(0, this->ID);
 	glTexImage2D(GL_TEXTURE_2D, 0, this->Internal_Format, width, height, 0, this->Image_Format, GL_UNSIGNED_BYTE, data);
 	glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -22,12 +64,9 @@ void Texture2D::Generate(unsigned int width, unsigned int height, unsigned char*
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, this->Wrap_T);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->Filter_Min);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, this->Filter_Max);
-
-	//unbind texture
-	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void Texture2D::Bind() const
+void Texture2D::Bind(unsigned int unit) const
 {
-	glBindTexture(GL_TEXTURE_2D, this->ID);
+	GLState::BindTexture(unit, this->ID);
 }
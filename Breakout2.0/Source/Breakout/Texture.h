@@ -1,14 +1,35 @@
 #pragma once
+
+// Non-owning reference to a texture, what drawing code takes. Valid for as long as the Texture2D it came from.
+struct TextureView
+{
+	unsigned int ID = 0;
+
+	// through GLState, which also makes unit the active one
+	void Bind(unsigned int unit = 0) const;
+};
+
+// Owns its GL texture: the name is created by the first Generate and deleted with the object.
+// Move-only, so exactly one Texture2D is responsible for every texture name.
 class Texture2D
 {
 public:
 	unsigned int ID;
 
 	Texture2D();
+	~Texture2D();
+
+	Texture2D(const Texture2D&) = delete;
+	Texture2D& operator=(const Texture2D&) = delete;
+	Texture2D(Texture2D&& other) noexcept;
+	Texture2D& operator=(Texture2D&& other) noexcept;
 
 	void Generate(unsigned int width, unsigned int height, unsigned char* data);
 
-	void Bind() const;
+	void Bind(unsigned int unit = 0) const;
+
+	inline TextureView View() const { return TextureView{ ID }; }
+	inline operator TextureView() const { return View(); }
 
 	unsigned int Width, Height;
 	unsigned int Internal_Format;
@@ -20,4 +41,3 @@ public:
 	unsigned int Filter_Max;
 };
 
-
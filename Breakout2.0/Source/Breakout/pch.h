@@ -13,6 +13,7 @@
 #include <unordered_set>
 #include <fstream>
 #include <tuple>
+#include <random>
 
 // GLM
 #include <glm/glm.hpp>S
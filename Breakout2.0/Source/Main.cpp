@@ -1,24 +1,79 @@
 #include "pch.h"
 #include "Game.h"
-int main()
+#include <Profiler.h>
+
+// longest frame the fixed step loop will catch up on, avoids a spiral of death after a stall
+const float MAX_FRAME_TIME = 0.25f;
+
+int main(int argc, char* argv[])
 {
+	// simulation rate in Hz, 0 steps the simulation once per rendered frame with a variable dt
+	float simRate = 240.0f;
+	// a fresh seed every run unless one is given to reproduce a game
+	Core.Seed = std::random_device()();
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--sim-hz" && i + 1 < argc)
+			simRate = std::max(0.0f, (float)std::atof(argv[++i]));
+		else if (arg == "--seed" && i + 1 < argc)
+			Core.Seed = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--record" && i + 1 < argc)
+			Core.RecordFile = argv[++i];
+		else if (arg == "--no-batch")
+			Core.BatchSprites = false;
+		else if (arg == "--bloom")
+			Core.Bloom = true;
+		else if (arg == "--trace" && i + 1 < argc)
+			Core.TraceFile = argv[++i];
+		else if (arg == "--trace-frames" && i + 1 < argc)
+			Core.TraceFrames = std::max(1, std::atoi(argv[++i]));
+	}
+	std::cout << "seed: " << Core.Seed << std::endl;
+	if (!Core.TraceFile.empty() && !Profiler::Enabled())
+		std::cout << "profiling is compiled out of this build, regenerate with premake --profile" << std::endl;
+
 	float dt = 0;
 	float curTime = 0;
 	float lastTime = 0;
+	float accumulator = 0;
 
 	Core.Init(); 
+	lastTime = (float)glfwGetTime();
 	while (Core.isRunning())
 	{
+		PROFILE_FRAME();
 		curTime = (float)glfwGetTime(); 
 		dt = curTime - lastTime;
 		lastTime = curTime;
 
-		Core.ProcessInput(dt);
-		Core.Update(dt);
-		Core.Render();
+		if (simRate > 0.0f)
+		{
+			// fixed step: the simulation runs at simRate no matter how fast we render
+			const float step = 1.0f / simRate;
+			accumulator += std::min(dt, MAX_FRAME_TIME);
+			while (accumulator >= step)
+			{
+				Core.ProcessInput(step);
+				Core.Update(step);
+				accumulator -= step;
+			}
+			Core.UpdateParticles(dt);
+			Core.Render(accumulator / step);
+		}
+		else
+		{
+			Core.ProcessInput(dt);
+			Core.Update(dt);
+			Core.UpdateParticles(dt);
+			Core.Render();
+		}
+
+		// F12 dumps the frames leading up to a hitch
+		if (Core.TraceRequested)
+			Core.WriteTrace();
 	}
 
 	Core.Clean();
 	return 0;
 }
-
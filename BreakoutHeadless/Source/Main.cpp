@@ -0,0 +1,62 @@
+#include "simpch.h"
+#include "Replay.h"
+#include <chrono>
+
+// Re-simulates recorded replays without a window, as fast as the CPU allows.
+// usage: BreakoutHeadless <replay> [--levels <dir>] [--repeat <n>]
+// exits with 1 when the replay cannot be read, does not fit the levels or the final state does not
+// match the recording
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cout << "usage: BreakoutHeadless <replay> [--levels <dir>] [--repeat <n>]" << std::endl;
+		return 1;
+	}
+
+	std::string levels = "../Breakout2.0/Source/Breakout/Levels";
+	unsigned int repeat = 1;
+	for (int i = 2; i < argc; ++i)
+	{
+		std::string arg = argv[i];
+		if (arg == "--levels" && i + 1 < argc)
+			levels = argv[++i];
+		else if (arg == "--repeat" && i + 1 < argc)
+			repeat = std::max(1, std::atoi(argv[++i]));
+	}
+
+	Replay replay;
+	if (!replay.Load(argv[1]))
+		return 1;
+
+	uint64_t hash = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned int i = 0; i < repeat; ++i)
+	{
+		Simulation sim(replay.Width, replay.Height);
+		sim.LoadLevel((levels + "/one.lvl").c_str());
+		sim.LoadLevel((levels + "/two.lvl").c_str());
+		if (!replay.Play(sim))
+			return 1;
+		hash = sim.Hash();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double frames = static_cast<double>(replay.Frames.size()) * repeat;
+	std::cout << replay.Frames.size() << " frames, seed " << replay.Seed << ", "
+		<< static_cast<unsigned long long>(frames / std::max(seconds, 1e-9)) << " frames/s" << std::endl;
+	std::cout << "final state 0x" << std::hex << hash << std::dec << std::endl;
+
+	if (!replay.HasHash)
+	{
+		std::cout << "replay has no recorded final state, nothing to verify against" << std::endl;
+		return 0;
+	}
+	if (hash != replay.FinalHash)
+	{
+		std::cout << "MISMATCH: recorded final state was 0x" << std::hex << replay.FinalHash << std::dec << std::endl;
+		return 1;
+	}
+	std::cout << "final state matches the recording" << std::endl;
+	return 0;
+}
@@ -0,0 +1,24 @@
+#include "simpch.h"
+#include "BallObject.h"
+
+BallObject::BallObject()
+	: GameObject(), Radius(12.5f), Stuck(true), Sticky(false), PassThrough(false) { }
+
+BallObject::BallObject(glm::vec2 pos, float radius, glm::vec2 velocity) : 
+	GameObject(pos, glm::vec2(radius * 2.0f), glm::vec3(1.0f), velocity), Radius(radius), Stuck(true), Sticky(false), PassThrough(false){}
+
+glm::vec2 BallObject::Move(float dt, unsigned int window_width)
+{
+	if (Stuck) return  Position;
+	MoveBall(Position.x, Position.y, Velocity.x, Velocity.y, Size.x, dt, static_cast<float>(window_width));
+	return Position;
+}
+
+void BallObject::Reset(glm::vec2 position, glm::vec2 velocity)
+{
+	Position = position;
+	Velocity = velocity;
+	Stuck = true;
+	Sticky = false;
+	PassThrough = false;
+}
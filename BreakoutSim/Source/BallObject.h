@@ -0,0 +1,38 @@
+#pragma once
+#include "GameObject.h"
+class BallObject :
+    public GameObject
+{
+public:
+    float Radius;
+    bool Stuck;
+    bool Sticky, PassThrough;
+
+    BallObject();
+    BallObject(glm::vec2 pos, float radius, glm::vec2 velocity);
+    glm::vec2 Move(float dt, unsigned int window_width);
+    void Reset(glm::vec2 position, glm::vec2 velocity);
+};
+
+// integrates a free moving ball and reflects it off the left, right and top walls.
+// works on plain floats so both BallObject and the batched state arrays share it
+inline void MoveBall(float& x, float& y, float& vx, float& vy, float size, float dt, float window_width)
+{
+    x += vx * dt;
+    y += vy * dt;
+    if (x <= 0.0f)
+    {
+        vx = -vx;
+        x = 0.0f;
+    }
+    if (x + size >= window_width)
+    {
+        vx = -vx;
+        x = window_width - size;
+    }
+    if (y <= 0.0f)
+    {
+        vy = -vy;
+        y = 0.0f;
+    }
+}
@@ -0,0 +1,61 @@
+#include "simpch.h"
+#include "Collision.h"
+
+// collision detection
+Direction VectorDirection(glm::vec2 target)
+{
+    glm::vec2 compass[]
+    {
+        glm::vec2(0,  1),  //up
+        glm::vec2(1,  0),  //right
+        glm::vec2(0, -1),  //down
+        glm::vec2(-1,  0)   //left
+    };
+    float max = 0.0f;
+    unsigned int best_match = -1;
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        float dot_product = glm::dot(target, compass[i]);
+        if (dot_product > max)
+        {
+            max = dot_product;
+            best_match = i;
+        }
+    }
+    return (Direction)best_match;
+}
+
+Collision CheckCollision(BallObject& one, GameObject& two)
+{
+    // get the center point of the circle
+    glm::vec2 center(one.Position + one.Radius);
+
+    // calculate the AAB (center & half extents);
+    glm::vec2 aab_half_extents = glm::vec2(two.Size.x / 2.0f, two.Size.y /2.0f);
+    glm::vec2 aab_center = two.Position + aab_half_extents;
+
+    // get vector from aab to center;
+    glm::vec2 difference = center - aab_center;
+    glm::vec2 clamped = glm::clamp(difference, -aab_half_extents, aab_half_extents); 
+
+    // get closest value by adding aab_center and clamped value
+    glm::vec2 closest_point = aab_center + clamped;
+    
+    // calculate difference and compare to radius
+    glm::vec2 diff = closest_point - center;
+    if (glm::length(diff) <= one.Radius)
+        return std::make_tuple(true, VectorDirection(difference), difference);
+    return std::make_tuple(false, UP, glm::vec2(0.0f, 0.0f));
+}
+
+bool CheckCollision(GameObject& one, GameObject& two) // AABB - AABB collision
+{
+    // collision x-axis?
+    bool collisionX = one.Position.x + one.Size.x >= two.Position.x &&
+        two.Position.x + two.Size.x >= one.Position.x;
+    // collision y-axis?
+    bool collisionY = one.Position.y + one.Size.y >= two.Position.y &&
+        two.Position.y + two.Size.y >= one.Position.y;
+    // collision only if on both axes
+    return collisionX && collisionY;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "BallObject.h"
+
+enum Direction
+{
+    UP, DOWN, LEFT, RIGHT
+};
+
+typedef std::tuple<bool, Direction, glm::vec2> Collision;
+
+// returns the compass direction the target vector is closest to
+Direction VectorDirection(glm::vec2 target);
+
+// circle - AABB collision
+Collision CheckCollision(BallObject& one, GameObject& two);
+
+// AABB - AABB collision
+bool CheckCollision(GameObject& one, GameObject& two);
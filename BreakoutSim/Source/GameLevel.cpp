@@ -1,10 +1,17 @@
-#include "pch.h"
+#include "simpch.h"
 #include "GameLevel.h"
-#include "ResourceManager.h"
+#include <atomic>
 
 void GameLevel::Load(const char* file, unsigned int levelWidth, unsigned int levelHeight)
 {
 	Bricks.clear();
+	DestroyedBits.clear();
+	Cells.clear();
+	GridWidth = GridHeight = 0;
+
+	// levels of different simulations load on WorkerPool threads at the same time
+	static std::atomic<unsigned int> nextLayoutId(0);
+	LayoutId = ++nextLayoutId;
 
 	unsigned int tileCode;
 	GameLevel level;
@@ -26,18 +33,31 @@ void GameLevel::Load(const char* file, unsigned int levelWidth, unsigned int lev
 	}
 }
 
-void GameLevel::Draw(SpriteRenderer& renderer)
+bool GameLevel::isComplete()
 {
-	for(GameObject& object : Bricks)
-	{
-		if(!object.Destroyed)
-		object.Draw(renderer);
-	}
+	return false;
 }
 
-bool GameLevel::isComplete()
+void GameLevel::ResetBricks()
 {
-	return false;
+	std::fill(DestroyedBits.begin(), DestroyedBits.end(), 0);
+}
+
+bool GameLevel::TileRange(glm::vec2 min, glm::vec2 max, unsigned int& x0, unsigned int& y0, unsigned int& x1, unsigned int& y1) const
+{
+	// widen by a hair so touching a tile edge still counts despite float rounding of brick positions
+	const float slack = 0.01f;
+	min -= slack;
+	max += slack;
+	if (GridWidth == 0 || GridHeight == 0 || max.x < 0.0f || max.y < 0.0f
+		|| min.x >= GridWidth * UnitWidth || min.y >= GridHeight * UnitHeight)
+		return false;
+
+	x0 = static_cast<unsigned int>(std::max(0.0f, min.x / UnitWidth));
+	y0 = static_cast<unsigned int>(std::max(0.0f, min.y / UnitHeight));
+	x1 = std::min(GridWidth - 1, static_cast<unsigned int>(max.x / UnitWidth));
+	y1 = std::min(GridHeight - 1, static_cast<unsigned int>(max.y / UnitHeight));
+	return true;
 }
 
 void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned int levelWidth, unsigned int levelHeight)
@@ -47,6 +67,12 @@ void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned i
 	float unit_width = levelWidth / static_cast<float>(width);
 	float unit_height = levelHeight/ static_cast<float>(height);
 
+	GridWidth = width;
+	GridHeight = height;
+	UnitWidth = unit_width;
+	UnitHeight = unit_height;
+	Cells.assign(width * height, -1);
+
 	for (unsigned int y = 0; y < height; ++y)
 	{
 		for (unsigned int x = 0; x < width; ++x)
@@ -55,10 +81,9 @@ void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned i
 			{
 				glm::vec2 pos(unit_width * x, unit_height * y);
 				glm::vec2 size(unit_width, unit_height);
-				GameObject obj(pos, size,
-					ResourceManager::GetTexture("block_solid"),
-					glm::vec3(0.8f, 0.8f, 0.7f));
+				GameObject obj(pos, size, glm::vec3(0.8f, 0.8f, 0.7f));
 				obj.IsSolid = true;
+				Cells[y * width + x] = static_cast<int>(Bricks.size());
 				Bricks.push_back(obj);
 			}
 			else if(tileData[y][x] > 1)
@@ -74,9 +99,10 @@ void GameLevel::init(std::vector<std::vector<unsigned int>> tileData, unsigned i
 					color = glm::vec3(1.0f, 0.5f, 0.0f);
 				glm::vec2 pos(unit_width * x, unit_height * y);
 				glm::vec2 size(unit_width, unit_height);
-				Bricks.push_back(GameObject(pos, size,
-					ResourceManager::GetTexture("block"), color));
+				Cells[y * width + x] = static_cast<int>(Bricks.size());
+				Bricks.push_back(GameObject(pos, size, color));
 			}
 		}
 	}
+	DestroyedBits.assign((Bricks.size() + 63) / 64, 0);
 }
@@ -0,0 +1,41 @@
+#pragma once
+#include "GameObject.h"
+class GameLevel
+{
+public:
+	std::vector<GameObject> Bricks;
+
+	// destroyed state of the bricks, bit i belongs to Bricks[i]. Kept as a bitset instead of
+	// GameObject::Destroyed so it snapshots and resets as a handful of words
+	std::vector<uint64_t> DestroyedBits;
+
+	// tile grid the bricks were laid out on; Cells holds the brick index of every tile, or -1 if empty
+	unsigned int GridWidth, GridHeight;
+	float UnitWidth, UnitHeight;
+	std::vector<int> Cells;
+
+	// changes whenever Load lays out a new set of bricks, so renderers know when cached brick data is stale
+	unsigned int LayoutId;
+	
+	GameLevel() : GridWidth(0), GridHeight(0), UnitWidth(0.0f), UnitHeight(0.0f), LayoutId(0) {}
+
+	void Load(const char* file, unsigned int levelWidth, unsigned int levelHeight);
+
+	bool isComplete();
+
+	inline bool IsDestroyed(unsigned int brick) const { return (DestroyedBits[brick >> 6] >> (brick & 63)) & 1; }
+	inline void SetDestroyed(unsigned int brick) { DestroyedBits[brick >> 6] |= uint64_t(1) << (brick & 63); }
+
+	// stands every brick back up
+	void ResetBricks();
+
+	// brick index at tile (x, y), -1 if the tile is empty
+	inline int BrickAt(unsigned int x, unsigned int y) const { return Cells[y * GridWidth + x]; }
+
+	// inclusive range of tiles overlapping the area [min, max], false if the area misses the grid
+	bool TileRange(glm::vec2 min, glm::vec2 max, unsigned int& x0, unsigned int& y0, unsigned int& x1, unsigned int& y1) const;
+private:
+	void init(std::vector<std::vector<unsigned int>> tileData,
+		unsigned int levelWidth, unsigned int levelHeight);
+};
+
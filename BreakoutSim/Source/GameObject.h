@@ -0,0 +1,13 @@
+#pragma once
+class GameObject
+{
+public:
+	glm::vec2 Position, Size, Velocity;
+	glm::vec3 Color;
+	float Rotation;
+	bool IsSolid;
+	bool Destroyed;
+
+	GameObject();
+	GameObject(glm::vec2 pos, glm::vec2 size, glm::vec3 color = glm::vec3(1.0f), glm::vec2 velocity = glm::vec2(0.0f, 0.0f));
+};
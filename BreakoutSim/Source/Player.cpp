@@ -0,0 +1,6 @@
+#include "simpch.h"
+#include "Player.h"
+
+Player::Player(glm::vec2 pos, glm::vec2 size, glm::vec3 color, glm::vec2 velocity) : GameObject(pos, size, color, velocity)
+{
+}
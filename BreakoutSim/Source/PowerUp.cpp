@@ -0,0 +1,69 @@
+#include "simpch.h"
+#include "PowerUp.h"
+#include "Simulation.h"
+
+static void applySpeed(Simulation& sim)
+{
+	sim.Ball.Velocity *= 1.2;
+}
+
+static void applySticky(Simulation& sim)
+{
+	sim.Ball.Sticky = true;
+	sim.Paddle.Color = glm::vec3(1.0f, 0.5f, 1.0f);
+}
+
+static void expireSticky(Simulation& sim)
+{
+	sim.Ball.Sticky = false;
+	sim.Paddle.Color = glm::vec3(1.0f);
+}
+
+static void applyPassThrough(Simulation& sim)
+{
+	sim.Ball.PassThrough = true;
+	sim.Ball.Color = glm::vec3(1.0f, 0.5f, 0.5f);
+}
+
+static void expirePassThrough(Simulation& sim)
+{
+	sim.Ball.PassThrough = false;
+	sim.Paddle.Color = glm::vec3(1.0f);
+}
+
+static void applyPadSizeIncrease(Simulation& sim)
+{
+	sim.Paddle.Size.x += 50;
+}
+
+static void applyConfuse(Simulation& sim)
+{
+	if (!sim.Chaos)
+		sim.Confuse = true; // only if chaos isn't already active
+}
+
+static void expireConfuse(Simulation& sim)
+{
+	sim.Confuse = false;
+}
+
+static void applyChaos(Simulation& sim)
+{
+	if (!sim.Confuse)
+		sim.Chaos = true;
+}
+
+static void expireChaos(Simulation& sim)
+{
+	sim.Chaos = false;
+}
+
+const PowerUpDefinition POWERUP_DEFINITIONS[POWERUP_TYPE_COUNT] = {
+	{ "speed",             75, glm::vec3(0.5f, 0.5f, 1.0f),   0.0f,  applySpeed,           nullptr },
+	{ "sticky",            75, glm::vec3(1.0f, 0.5f, 1.0f),   20.0f, applySticky,          expireSticky },
+	{ "pass-through",      75, glm::vec3(0.5f, 1.0f, 0.5f),   10.0f, applyPassThrough,     expirePassThrough },
+	{ "pad-size-increase", 75, glm::vec3(1.0f, 0.6f, 0.4f),   0.0f,  applyPadSizeIncrease, nullptr },
+	// negative powerups should spawn more often
+	{ "confuse",           15, glm::vec3(1.0f, 0.3f, 0.3f),   15.0f, applyConfuse,         expireConfuse },
+	{ "chaos",             15, glm::vec3(0.9f, 0.25f, 0.25f), 15.0f, applyChaos,           expireChaos }
+};
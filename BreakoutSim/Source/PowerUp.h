@@ -0,0 +1,49 @@
+#pragma once
+#include "GameObject.h"
+
+// The size of a PowerUp block
+const glm::vec2 POWERUP_SIZE(60.0f, 20.0f);
+// Velocity a PowerUp block has when spawned
+const glm::vec2 VELOCITY(0.0f, 150.0f);
+
+// every power-up type, also its index into POWERUP_DEFINITIONS (and in snapshots)
+enum PowerUpType
+{
+	POWERUP_SPEED,
+	POWERUP_STICKY,
+	POWERUP_PASS_THROUGH,
+	POWERUP_PAD_SIZE_INCREASE,
+	POWERUP_CONFUSE,
+	POWERUP_CHAOS,
+	POWERUP_TYPE_COUNT
+};
+
+class Simulation;
+
+// what a power-up type is and does; spawn rolls go through the table in type order
+struct PowerUpDefinition
+{
+	// stable name, folded into Simulation::Hash
+	const char* Name;
+	// spawns with a 1 in Chance probability per destroyed brick
+	unsigned int Chance;
+	glm::vec3 Color;
+	// seconds the effect lasts after pickup, 0 for instant ones
+	float Duration;
+	void (*Apply)(Simulation& sim);
+	// runs once the last active power-up of the type runs out, null if nothing has to be undone
+	void (*Expire)(Simulation& sim);
+};
+
+extern const PowerUpDefinition POWERUP_DEFINITIONS[POWERUP_TYPE_COUNT];
+
+class PowerUp : public GameObject
+{
+public:
+	PowerUpType Type;
+	// collected and its effect has not run out yet
+	bool Activated;
+
+	PowerUp(PowerUpType type, glm::vec2 position)
+		: GameObject(position, POWERUP_SIZE, POWERUP_DEFINITIONS[type].Color, VELOCITY), Type(type), Activated() { }
+};
@@ -0,0 +1,73 @@
+#include "simpch.h"
+#include "PowerUpPool.h"
+
+// generations move on at every spawn and despawn, so a free slot is always at one no handle was
+// given out for; 0 is skipped on wrap around since it marks stale handles
+static inline void nextGeneration(unsigned int& generation)
+{
+	if (++generation == 0)
+		generation = 1;
+}
+
+PowerUpPool::PowerUpPool(unsigned int capacity)
+	:slots(capacity, PowerUp(POWERUP_SPEED, glm::vec2(0.0f))), generations(capacity, 1), positions(capacity, 0)
+{
+	free.reserve(capacity);
+	live.reserve(capacity);
+	Clear();
+}
+
+PowerUpHandle PowerUpPool::Spawn(PowerUpType type, glm::vec2 position)
+{
+	if (free.empty())
+		return PowerUpHandle();
+
+	unsigned int slot = free.back();
+	free.pop_back();
+	slots[slot] = PowerUp(type, position);
+	nextGeneration(generations[slot]);
+	positions[slot] = static_cast<unsigned int>(live.size());
+	live.push_back(slot);
+	return { slot, generations[slot] };
+}
+
+void PowerUpPool::Clear()
+{
+	for (unsigned int slot : live)
+		nextGeneration(generations[slot]);
+	live.clear();
+	free.clear();
+	// handed out from the back, so slot 0 goes first
+	for (unsigned int slot = Capacity(); slot > 0; --slot)
+		free.push_back(slot - 1);
+}
+
+void PowerUpPool::release(unsigned int slot)
+{
+	nextGeneration(generations[slot]);
+	free.push_back(slot);
+}
+
+PowerUp* PowerUpPool::Get(PowerUpHandle handle)
+{
+	if (handle.Generation == 0 || handle.Slot >= Capacity() || generations[handle.Slot] != handle.Generation)
+		return nullptr;
+	return &slots[handle.Slot];
+}
+
+const PowerUp* PowerUpPool::Get(PowerUpHandle handle) const
+{
+	return const_cast<PowerUpPool*>(this)->Get(handle);
+}
+
+PowerUpHandle PowerUpPool::HandleAt(unsigned int i) const
+{
+	return { live[i], generations[live[i]] };
+}
+
+int PowerUpPool::IndexOf(PowerUpHandle handle) const
+{
+	if (!Get(handle))
+		return -1;
+	return static_cast<int>(positions[handle.Slot]);
+}
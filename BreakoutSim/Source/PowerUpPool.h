@@ -0,0 +1,92 @@
+#pragma once
+#include "PowerUp.h"
+
+// more than ever fall or stay active at once in practice; spawns beyond it are skipped
+const unsigned int POWERUP_POOL_CAPACITY = 128;
+
+// refers to one pooled power-up; goes stale once that power-up is despawned, even if its slot is reused
+struct PowerUpHandle
+{
+	unsigned int Slot;
+	// 0 never belongs to a live power-up, so a default handle is always stale
+	unsigned int Generation = 0;
+};
+
+// Fixed capacity power-up storage. A power-up keeps its slot from spawn to despawn, so neither
+// allocates or moves any other power-up; the occupied slots are listed densely in spawn order,
+// which is the order the simulation visits (and hashes) them in.
+class PowerUpPool
+{
+public:
+	template<typename Value>
+	class Iterator
+	{
+	public:
+		Iterator(Value* slots, const unsigned int* live) : slots(slots), live(live) {}
+		Value& operator*() const { return slots[*live]; }
+		Iterator& operator++() { ++live; return *this; }
+		bool operator!=(const Iterator& other) const { return live != other.live; }
+	private:
+		Value* slots;
+		const unsigned int* live;
+	};
+
+	explicit PowerUpPool(unsigned int capacity = POWERUP_POOL_CAPACITY);
+
+	// a stale handle if the pool is full
+	PowerUpHandle Spawn(PowerUpType type, glm::vec2 position);
+	// calls despawn on every live power-up in spawn order and removes those it returns true for; the
+	// rest keep their order and move up over the gaps, all in one pass however many go
+	template<typename Predicate>
+	void DespawnIf(Predicate despawn);
+	void Clear();
+
+	// null if the handle is stale
+	PowerUp* Get(PowerUpHandle handle);
+	const PowerUp* Get(PowerUpHandle handle) const;
+	PowerUpHandle HandleAt(unsigned int i) const;
+	// position of the handle's power-up in spawn order, -1 if the handle is stale; constant time
+	int IndexOf(PowerUpHandle handle) const;
+
+	// the i-th live power-up in spawn order
+	inline PowerUp& operator[](unsigned int i) { return slots[live[i]]; }
+	inline const PowerUp& operator[](unsigned int i) const { return slots[live[i]]; }
+	inline unsigned int Size() const { return static_cast<unsigned int>(live.size()); }
+	inline unsigned int Capacity() const { return static_cast<unsigned int>(slots.size()); }
+
+	// live power-ups in spawn order
+	Iterator<PowerUp> begin() { return Iterator<PowerUp>(slots.data(), live.data()); }
+	Iterator<PowerUp> end() { return Iterator<PowerUp>(slots.data(), live.data() + live.size()); }
+	Iterator<const PowerUp> begin() const { return Iterator<const PowerUp>(slots.data(), live.data()); }
+	Iterator<const PowerUp> end() const { return Iterator<const PowerUp>(slots.data(), live.data() + live.size()); }
+private:
+	std::vector<PowerUp> slots;
+	std::vector<unsigned int> generations;
+	// unused slots, taken from the back
+	std::vector<unsigned int> free;
+	// occupied slots in spawn order
+	std::vector<unsigned int> live;
+	// where each occupied slot is in live, so handles find their power-up's place without a search
+	std::vector<unsigned int> positions;
+
+	void release(unsigned int slot);
+};
+
+template<typename Predicate>
+void PowerUpPool::DespawnIf(Predicate despawn)
+{
+	unsigned int kept = 0;
+	for (unsigned int i = 0; i < live.size(); ++i)
+	{
+		unsigned int slot = live[i];
+		if (despawn(slots[slot]))
+		{
+			release(slot);
+			continue;
+		}
+		live[kept] = slot;
+		positions[slot] = kept;
+		++kept;
+	}
+	live.resize(kept);
+}
@@ -0,0 +1,107 @@
+#include "simpch.h"
+#include "Profiler.h"
+#include <mutex>
+#include <iomanip>
+
+namespace
+{
+	struct ThreadBuffer
+	{
+		std::vector<ProfileEvent> Events;
+		uint64_t Count;
+		unsigned int Thread;
+	};
+
+	// buffers are owned here so they outlive the threads that filled them
+	std::mutex registryMutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> registry;
+	thread_local ThreadBuffer* current = nullptr;
+
+	uint64_t frameStarts[Profiler::MAX_FRAMES];
+	uint64_t frameCount = 0;
+
+	ThreadBuffer* registerThread()
+	{
+		std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+		buffer->Events.resize(Profiler::BUFFER_SIZE);
+		buffer->Count = 0;
+
+		std::lock_guard<std::mutex> lock(registryMutex);
+		buffer->Thread = static_cast<unsigned int>(registry.size());
+		registry.push_back(std::move(buffer));
+		return registry.back().get();
+	}
+
+	void writeEvent(std::ostream& out, const ProfileEvent& event, unsigned int thread, uint64_t origin, bool& first)
+	{
+		if (!first)
+			out << ",\n";
+		first = false;
+		// trace_event wants microseconds, keep the nanoseconds as decimals
+		out << "{\"name\":\"" << event.Name << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread
+			<< ",\"ts\":" << (event.Start - origin) / 1000.0
+			<< ",\"dur\":" << (event.End - event.Start) / 1000.0 << "}";
+	}
+}
+
+void Profiler::Record(const char* name, uint64_t start, uint64_t end)
+{
+	ThreadBuffer* buffer = current;
+	if (!buffer)
+		buffer = current = registerThread();
+	buffer->Events[buffer->Count++ & (BUFFER_SIZE - 1)] = { name, start, end };
+}
+
+void Profiler::BeginFrame()
+{
+	uint64_t now = Now();
+	if (frameCount > 0)
+		Record("Frame", frameStarts[(frameCount - 1) % MAX_FRAMES], now);
+	frameStarts[frameCount++ % MAX_FRAMES] = now;
+}
+
+bool Profiler::WriteTrace(const char* file, unsigned int frames)
+{
+	std::ofstream out(file);
+	if (!out)
+	{
+		std::cout << "ERROR::PROFILER: Failed to open trace file " << file << std::endl;
+		return false;
+	}
+
+	// events that started before the oldest requested frame are left out
+	uint64_t origin = 0;
+	if (frameCount > 0)
+	{
+		uint64_t kept = std::min<uint64_t>(frameCount, MAX_FRAMES);
+		uint64_t count = std::max<uint64_t>(1, std::min<uint64_t>(frames, kept));
+		origin = frameStarts[(frameCount - count) % MAX_FRAMES];
+	}
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\"traceEvents\":[\n";
+	bool first = true;
+	std::lock_guard<std::mutex> lock(registryMutex);
+	for (const std::unique_ptr<ThreadBuffer>& buffer : registry)
+	{
+		// oldest surviving event first
+		uint64_t begin = buffer->Count > BUFFER_SIZE ? buffer->Count - BUFFER_SIZE : 0;
+		for (uint64_t i = begin; i < buffer->Count; ++i)
+		{
+			const ProfileEvent& event = buffer->Events[i & (BUFFER_SIZE - 1)];
+			if (event.Start >= origin)
+				writeEvent(out, event, buffer->Thread, origin, first);
+		}
+	}
+	out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	return static_cast<bool>(out);
+}
+
+bool Profiler::Enabled()
+{
+#ifdef BREAKOUT_PROFILE
+	return true;
+#else
+	return false;
+#endif
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+// one finished scope, times are steady clock nanoseconds
+struct ProfileEvent
+{
+	const char* Name;
+	uint64_t Start, End;
+};
+
+// Collects scoped timings into a ring buffer per thread and writes the last few frames
+// as a Chrome trace_event file (load it in chrome://tracing or ui.perfetto.dev).
+// Recording never locks or allocates once a thread's buffer exists. WriteTrace reads the
+// buffers of every thread, so call it between frames while no worker is inside a scope.
+class Profiler
+{
+public:
+	// events kept per thread, older ones are overwritten
+	static const unsigned int BUFFER_SIZE = 1 << 16;
+	// frame starts kept, the most WriteTrace can go back
+	static const unsigned int MAX_FRAMES = 1024;
+
+	static inline uint64_t Now()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	static void Record(const char* name, uint64_t start, uint64_t end);
+
+	// marks the start of a new frame, the previous one shows up as a "Frame" event
+	static void BeginFrame();
+
+	// writes every event that started within the last `frames` frames, false if the file can't be written
+	static bool WriteTrace(const char* file, unsigned int frames);
+
+	// true when the PROFILE_ macros were compiled in
+	static bool Enabled();
+private:
+	Profiler() { }
+};
+
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* name)
+		: name(name), start(Profiler::Now()) { }
+	~ProfileScope() { Profiler::Record(name, start, Profiler::Now()); }
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+	const char* name;
+	uint64_t start;
+};
+
+// define BREAKOUT_PROFILE (premake --profile) to compile the instrumentation in
+#ifdef BREAKOUT_PROFILE
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_FRAME() Profiler::BeginFrame()
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_FRAME()
+#endif
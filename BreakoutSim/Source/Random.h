@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+
+// Small, fast PCG32 random number generator (O'Neill, pcg-random.org).
+// Every game owns its own instance so parallel games neither share nor contend on state,
+// and the whole generator is two integers so it snapshots with a plain copy.
+class Pcg32
+{
+public:
+	uint64_t State;
+	uint64_t Increment;
+
+	Pcg32() { Seed(0x853c49e6748fea9bULL); }
+	explicit Pcg32(uint64_t seed, uint64_t stream = 0) { Seed(seed, stream); }
+
+	// seeds the generator; different streams with the same seed give independent sequences
+	inline void Seed(uint64_t seed, uint64_t stream = 0)
+	{
+		State = 0u;
+		Increment = (stream << 1u) | 1u;
+		Next();
+		State += seed;
+		Next();
+	}
+
+	// uniformly distributed 32 bit value
+	inline uint32_t Next()
+	{
+		uint64_t old = State;
+		State = old * 6364136223846793005ULL + Increment;
+		uint32_t xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+		uint32_t rot = static_cast<uint32_t>(old >> 59u);
+		return (xorshifted >> rot) | (xorshifted << ((~rot + 1u) & 31u));
+	}
+
+	// uniformly distributed value in [0, bound), bound must be > 0 (Lemire's multiply-shift)
+	inline uint32_t NextBounded(uint32_t bound)
+	{
+		uint64_t m = static_cast<uint64_t>(Next()) * bound;
+		uint32_t low = static_cast<uint32_t>(m);
+		if (low < bound)
+		{
+			uint32_t threshold = (~bound + 1u) % bound;
+			while (low < threshold)
+			{
+				m = static_cast<uint64_t>(Next()) * bound;
+				low = static_cast<uint32_t>(m);
+			}
+		}
+		return static_cast<uint32_t>(m >> 32u);
+	}
+
+	// uniformly distributed value in [0, 1)
+	inline float NextFloat()
+	{
+		return (Next() >> 8) * (1.0f / 16777216.0f);
+	}
+};
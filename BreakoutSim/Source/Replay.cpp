@@ -0,0 +1,173 @@
+#include "simpch.h"
+#include "Replay.h"
+
+static const char REPLAY_MAGIC[4] = { 'B', 'R', 'P', 'L' };
+// 2: timed effects end on the simulation clock, games recorded before play back differently
+static const uint16_t REPLAY_VERSION = 2;
+static const unsigned char REPLAY_END = 0xFF;
+static const unsigned char REPLAY_NEW_DT = 1 << 3;
+static const unsigned int REPLAY_MAX_RUN = 15;
+
+template<typename T>
+static void writeValue(std::ofstream& stream, const T& value)
+{
+	stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+static bool readValue(std::ifstream& stream, T& value)
+{
+	return static_cast<bool>(stream.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+static unsigned char packInput(const SimInput& input)
+{
+	return (input.Left ? 1 : 0) | (input.Right ? 2 : 0) | (input.Launch ? 4 : 0);
+}
+
+static SimInput unpackInput(unsigned char bits)
+{
+	SimInput input;
+	input.Left = (bits & 1) != 0;
+	input.Right = (bits & 2) != 0;
+	input.Launch = (bits & 4) != 0;
+	return input;
+}
+
+ReplayWriter::ReplayWriter()
+	: frameCount(0), runInput(0), runDt(0.0f), runLength(0), lastDt(0.0f), hasDt(false) {}
+
+ReplayWriter::~ReplayWriter()
+{
+	if (IsOpen())
+		stream.close();
+}
+
+bool ReplayWriter::Open(const char* file, uint64_t seed, unsigned int width, unsigned int height, unsigned int level)
+{
+	stream.open(file, std::ios::binary | std::ios::trunc);
+	if (!stream)
+	{
+		std::cout << "ERROR::REPLAY: Failed to open " << file << " for writing" << std::endl;
+		return false;
+	}
+	frameCount = 0;
+	runLength = 0;
+	hasDt = false;
+
+	stream.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+	writeValue(stream, REPLAY_VERSION);
+	writeValue(stream, uint16_t(0));
+	writeValue(stream, seed);
+	writeValue(stream, uint32_t(width));
+	writeValue(stream, uint32_t(height));
+	writeValue(stream, uint32_t(level));
+	return true;
+}
+
+void ReplayWriter::Record(const SimInput& input, float dt)
+{
+	if (!IsOpen())
+		return;
+	unsigned char bits = packInput(input);
+	if (runLength > 0 && (bits != runInput || dt != runDt || runLength == REPLAY_MAX_RUN))
+		flushRun();
+	runInput = bits;
+	runDt = dt;
+	++runLength;
+	++frameCount;
+}
+
+void ReplayWriter::Close(uint64_t finalHash)
+{
+	if (!IsOpen())
+		return;
+	if (runLength > 0)
+		flushRun();
+	writeValue(stream, REPLAY_END);
+	writeValue(stream, frameCount);
+	writeValue(stream, finalHash);
+	stream.close();
+}
+
+void ReplayWriter::flushRun()
+{
+	bool newDt = !hasDt || runDt != lastDt;
+	unsigned char header = runInput | (newDt ? REPLAY_NEW_DT : 0) | ((runLength - 1) << 4);
+	writeValue(stream, header);
+	if (newDt)
+	{
+		writeValue(stream, runDt);
+		lastDt = runDt;
+		hasDt = true;
+	}
+	runLength = 0;
+}
+
+Replay::Replay()
+	: Seed(0), Width(0), Height(0), Level(0), HasHash(false), FinalHash(0) {}
+
+bool Replay::Load(const char* file)
+{
+	Frames.clear();
+	HasHash = false;
+
+	std::ifstream stream(file, std::ios::binary);
+	char magic[4];
+	uint16_t version, reserved;
+	uint32_t width, height, level;
+	if (!stream.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, REPLAY_MAGIC)
+		|| !readValue(stream, version) || version != REPLAY_VERSION || !readValue(stream, reserved)
+		|| !readValue(stream, Seed) || !readValue(stream, width) || !readValue(stream, height) || !readValue(stream, level))
+	{
+		std::cout << "ERROR::REPLAY: " << file << " is not a valid replay" << std::endl;
+		return false;
+	}
+	if (width == 0 || height == 0)
+	{
+		std::cout << "ERROR::REPLAY: " << file << " has an empty play field" << std::endl;
+		return false;
+	}
+	Width = width;
+	Height = height;
+	Level = level;
+
+	float dt = 0.0f;
+	unsigned char header;
+	while (readValue(stream, header))
+	{
+		if (header == REPLAY_END)
+		{
+			uint64_t frameCount;
+			HasHash = readValue(stream, frameCount) && readValue(stream, FinalHash) && frameCount == Frames.size();
+			break;
+		}
+		if ((header & REPLAY_NEW_DT) && !readValue(stream, dt))
+			break;
+		ReplayFrame frame;
+		frame.Input = unpackInput(header & 7);
+		frame.Dt = dt;
+		Frames.insert(Frames.end(), (header >> 4) + 1, frame);
+	}
+	return true;
+}
+
+bool Replay::Play(Simulation& sim) const
+{
+	if (Width != sim.Width || Height != sim.Height)
+	{
+		std::cout << "ERROR::REPLAY: recorded on a " << Width << "x" << Height << " play field, not " << sim.Width << "x" << sim.Height << std::endl;
+		return false;
+	}
+	if (Level >= sim.Levels.size())
+	{
+		std::cout << "ERROR::REPLAY: starts on level " << Level << " but only " << sim.Levels.size() << " are loaded" << std::endl;
+		return false;
+	}
+
+	sim.Seed(Seed);
+	sim.Level = Level;
+	for (const ReplayFrame& frame : Frames)
+		sim.Step(frame.Input, frame.Dt);
+	return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "Simulation.h"
+
+// one recorded simulation step
+struct ReplayFrame
+{
+	SimInput Input;
+	float Dt;
+};
+
+// Replay file layout (little endian):
+//   header  "BRPL", u16 version, u16 reserved, u64 seed, u32 width, u32 height, u32 level
+//   frames  one byte per run of identical steps: bits 0-2 Left/Right/Launch, bit 3 set when a
+//           new f32 dt follows, bits 4-7 run length - 1 (0-14)
+//   trailer 0xFF, u64 frame count, u64 final Simulation::Hash
+// With a fixed timestep dt is written once, so held input costs one byte per 15 steps.
+
+// streams steps to a replay file while a game is played
+class ReplayWriter
+{
+public:
+	ReplayWriter();
+	~ReplayWriter();
+
+	bool Open(const char* file, uint64_t seed, unsigned int width, unsigned int height, unsigned int level);
+	void Record(const SimInput& input, float dt);
+
+	// writes the trailer, finalHash lets playback verify it reproduced the game exactly
+	void Close(uint64_t finalHash);
+
+	inline bool IsOpen() const { return stream.is_open(); }
+private:
+	std::ofstream stream;
+	uint64_t frameCount;
+
+	// pending run of identical steps
+	unsigned char runInput;
+	float runDt;
+	unsigned int runLength;
+
+	float lastDt;
+	bool hasDt;
+
+	void flushRun();
+};
+
+// a fully loaded replay
+class Replay
+{
+public:
+	uint64_t Seed;
+	unsigned int Width, Height, Level;
+	std::vector<ReplayFrame> Frames;
+
+	// false for replays that were not closed properly (e.g. the game crashed)
+	bool HasHash;
+	uint64_t FinalHash;
+
+	Replay();
+
+	bool Load(const char* file);
+
+	// re-simulates every frame on a freshly constructed simulation with the levels loaded;
+	// seed and starting level are applied here. False (and nothing simulated) if the replay was
+	// recorded on a different play field or starts on a level sim does not have
+	bool Play(Simulation& sim) const;
+};
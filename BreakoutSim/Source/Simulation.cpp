@@ -0,0 +1,553 @@
+#include "simpch.h"
+#include "Simulation.h"
+#include "Collision.h"
+#include "Profiler.h"
+
+// Player
+const glm::vec2 PLAYER_SIZE(100.0f, 20.0f);
+const float PLAYER_VELOCITY(500.0f);
+
+// Ball
+const glm::vec2 INITIAL_BALL_VELOCITY(100.0f, -350.0f);
+const float BALL_RADIUS = 12.5f;
+
+static glm::vec2 initialPlayerPosition(unsigned int width, unsigned int height)
+{
+    return glm::vec2(width / 2.0f - PLAYER_SIZE.x / 2.0f, height - PLAYER_SIZE.y);
+}
+
+Simulation::Simulation(unsigned int width, unsigned int height, uint64_t seed)
+    : State(GAME_ACTIVE), Width(width), Height(height), ActiveCount(), Level(0),
+    Paddle(initialPlayerPosition(width, height), PLAYER_SIZE),
+    Ball(initialPlayerPosition(width, height) + glm::vec2(PLAYER_SIZE.x / 2.0f - BALL_RADIUS, -BALL_RADIUS * 2.0f), BALL_RADIUS, INITIAL_BALL_VELOCITY),
+    Confuse(false), Chaos(false), Shake(false), Time(0.0), ShakeEnd(0.0), Rng(seed)
+{
+}
+
+void Simulation::Seed(uint64_t seed, uint64_t stream)
+{
+    Rng.Seed(seed, stream);
+}
+
+void Simulation::LoadLevel(const char* file)
+{
+    GameLevel level; level.Load(file, Width, Height / 2);
+    Levels.push_back(level);
+}
+
+void Simulation::ProcessInput(const SimInput& input, float dt)
+{
+    if (State == GAME_ACTIVE)
+    {
+        MovePaddle(input, dt, Paddle.Position.x, Paddle.Size.x, Ball.Position.x, Ball.Stuck, Width);
+        if (input.Launch)
+        {
+            Ball.Stuck = false;
+        }
+    }
+}
+
+void Simulation::Update(float dt)
+{
+    Ball.Move(dt, Width);
+    resolve(dt);
+}
+
+void Simulation::resolve(float dt)
+{
+    Events.clear();
+    DoCollision();
+    UpdatePowerUps(dt);
+    // the step's time passes, then the effects that ran out during it end
+    Time += dt;
+    Timer timer;
+    bool powerUpsEnded = false;
+    while (Timers.PopExpired(Time, timer))
+    {
+        fireTimer(timer);
+        powerUpsEnded |= timer.Type == TIMER_POWERUP_END;
+    }
+    // the power-ups whose effect ran out go together, in one pass over the live ones
+    if (powerUpsEnded)
+        PowerUps.DespawnIf([](const PowerUp& powerup) { return powerup.Destroyed && !powerup.Activated; });
+    // check loss condition
+    if (Ball.Position.y >= Height)
+    {
+        ResetLevel();
+    }
+}
+
+void Simulation::Step(const SimInput& input, float dt)
+{
+    ProcessInput(input, dt);
+    Update(dt);
+}
+
+void Simulation::DoCollision()
+{
+    PROFILE_FUNCTION();
+    Collision colPlayer = CheckCollision(Ball, Paddle);
+    if (!Ball.Stuck && std::get<0>(colPlayer))
+    {
+        float centerBoard = Paddle.Position.x + (Paddle.Size.x / 2.0f);
+        float distance = (Ball.Position.x + Ball.Radius) - centerBoard;
+        float percentage = distance / (Paddle.Size.x / 2.0f);
+
+        float strength = 2.0f;
+        glm::vec2 oldVelocity = Ball.Velocity;
+        Ball.Velocity.x = INITIAL_BALL_VELOCITY.x * percentage * strength;
+        Ball.Velocity.y = -1.0f * std::abs(Ball.Velocity.y);
+        Ball.Velocity = glm::normalize(Ball.Velocity) * glm::length(oldVelocity);
+
+        Ball.Stuck = Ball.Sticky;
+    }
+    // broadphase: bricks sit on the level's tile grid, so only the tiles under the ball's
+    // bounding box can hold a brick it touches
+    GameLevel& level = Levels[Level];
+    unsigned int x0, y0, x1, y1;
+    if (level.TileRange(Ball.Position, Ball.Position + Ball.Size, x0, y0, x1, y1))
+    {
+        for (unsigned int y = y0; y <= y1; ++y)
+        {
+            for (unsigned int x = x0; x <= x1; ++x)
+            {
+                int index = level.BrickAt(x, y);
+                if (index < 0 || level.IsDestroyed(index))
+                    continue;
+                collideBrick(level, index);
+            }
+        }
+    }
+    for (unsigned int i = 0; i < PowerUps.Size(); ++i)
+    {
+        PowerUp& powerup = PowerUps[i];
+        if (!powerup.Destroyed)
+        {
+            if (powerup.Position.y >= Height)
+                powerup.Destroyed = true;
+            if (CheckCollision(Paddle, powerup))
+            {
+                activatePowerUp(PowerUps.HandleAt(i));
+                powerup.Destroyed = true;
+                Events.push_back({ EVENT_POWERUP_COLLECTED, powerup.Position + powerup.Size * 0.5f, powerup.Color });
+            }
+        }
+    }
+}
+
+void Simulation::collideBrick(GameLevel& level, unsigned int index)
+{
+    GameObject& brick = level.Bricks[index];
+    Collision col = CheckCollision(Ball, brick);
+    if (std::get<0>(col)) // if collision is true
+    {
+        if (!brick.IsSolid)
+        {
+            level.SetDestroyed(index);
+            Events.push_back({ EVENT_BRICK_DESTROYED, brick.Position + brick.Size * 0.5f, brick.Color });
+        }
+        ShakeEnd = Time + 0.05;
+        Timers.Schedule(ShakeEnd, TIMER_SHAKE_END);
+        Shake = true; // shake effects
+        SpawnPowerUps(brick); // handle spawn power up
+
+        Direction dir = std::get<1>(col);
+        glm::vec2 diff_vector = std::get<2>(col);
+        if (!Ball.PassThrough) // do not resolve collision if pass through is active
+        {
+            if (dir == LEFT || dir == RIGHT) // horizontal collision
+            {
+                Ball.Velocity.x = -Ball.Velocity.x;
+
+                float penetration = Ball.Radius - std::abs(diff_vector.x);
+                if (dir == LEFT)
+                    Ball.Position.x += penetration;
+                else
+                    Ball.Position.x -= penetration;
+            }
+            else
+            {
+                Ball.Velocity.y = -Ball.Velocity.y;
+
+                float penetration = Ball.Radius - std::abs(diff_vector.y);
+
+                if (dir == UP)
+                    Ball.Position.y -= penetration;
+                if (dir == DOWN)
+                    Ball.Position.y += penetration;
+            }
+        }
+    }
+}
+
+void Simulation::SpawnPowerUps(GameObject& block)
+{
+    // every type rolls once, in table order so the random sequence stays the same
+    for (unsigned int type = 0; type < POWERUP_TYPE_COUNT; ++type)
+    {
+        if (shouldSpawn(POWERUP_DEFINITIONS[type].Chance))
+            PowerUps.Spawn(static_cast<PowerUpType>(type), block.Position);
+    }
+}
+
+void Simulation::UpdatePowerUps(float dt)
+{
+    PROFILE_FUNCTION();
+    PowerUps.DespawnIf([dt](PowerUp& powerup)
+    {
+        powerup.Position += powerup.Velocity * dt;
+        // fell off the screen; collected ones stay until their effect's timer fires
+        return powerup.Destroyed && !powerup.Activated;
+    });
+}
+
+void Simulation::ResetLevel()
+{
+    // reset player
+    Paddle.Position.x = Width / 2.0f - PLAYER_SIZE.x / 2.0f;
+
+    // reset ball
+    glm::vec2 startBallPos = glm::vec2(Width / 2.0f - Ball.Size.x / 2.0f, Height - Ball.Size.y - Paddle.Size.y);
+    Ball.Reset(startBallPos, INITIAL_BALL_VELOCITY);
+    Ball.Stuck = true;
+
+    // active power-ups run out with the next step
+    for (unsigned int i = 0; i < PowerUps.Size(); ++i)
+    {
+        if (PowerUps[i].Activated)
+            Timers.Schedule(Time, TIMER_POWERUP_END, PowerUps.HandleAt(i));
+    }
+
+    // reset level
+    Levels[Level].ResetBricks();
+}
+
+// FNV-1a, folds raw bytes into the running hash
+static uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template<typename T>
+static uint64_t hashValue(uint64_t hash, const T& value)
+{
+    return hashBytes(hash, &value, sizeof(T));
+}
+
+static uint64_t hashObject(uint64_t hash, const GameObject& object)
+{
+    hash = hashValue(hash, object.Position);
+    hash = hashValue(hash, object.Size);
+    hash = hashValue(hash, object.Velocity);
+    hash = hashValue(hash, object.Color);
+    return hashValue(hash, object.Destroyed);
+}
+
+uint64_t Simulation::Hash() const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    hash = hashValue(hash, State);
+    hash = hashValue(hash, Level);
+    hash = hashObject(hash, Paddle);
+    hash = hashObject(hash, Ball);
+    hash = hashValue(hash, Ball.Stuck);
+    hash = hashValue(hash, Ball.Sticky);
+    hash = hashValue(hash, Ball.PassThrough);
+    hash = hashValue(hash, Confuse);
+    hash = hashValue(hash, Chaos);
+    hash = hashValue(hash, Shake);
+    hash = hashValue(hash, Time);
+    hash = hashValue(hash, ShakeEnd);
+    hash = hashValue(hash, Rng.State);
+    for (const PowerUp& powerup : PowerUps)
+    {
+        hash = hashObject(hash, powerup);
+        const char* name = POWERUP_DEFINITIONS[powerup.Type].Name;
+        hash = hashBytes(hash, name, std::strlen(name));
+        hash = hashValue(hash, powerup.Activated);
+    }
+    // power-ups by position rather than slot, slots are not kept across snapshots
+    for (unsigned int i = 0; i < Timers.Size(); ++i)
+    {
+        hash = hashValue(hash, Timers[i].Deadline);
+        hash = hashValue(hash, Timers[i].Type);
+        hash = hashValue(hash, PowerUps.IndexOf(Timers[i].PowerUp));
+    }
+    const std::vector<uint64_t>& bricks = Levels[Level].DestroyedBits;
+    hash = hashBytes(hash, bricks.data(), bricks.size() * sizeof(uint64_t));
+    return hash;
+}
+
+// fixed part of a snapshot, followed by PowerUpCount SnapshotPowerUp, TimerCount SnapshotTimer
+// and BrickWords uint64_t
+struct SnapshotHeader
+{
+    GameState State;
+    unsigned int Level;
+
+    glm::vec2 BallPosition, BallVelocity, BallSize;
+    glm::vec3 BallColor;
+    float BallRadius;
+    bool BallStuck, BallSticky, BallPassThrough;
+
+    glm::vec2 PaddlePosition, PaddleSize;
+    glm::vec3 PaddleColor;
+
+    bool Confuse, Chaos, Shake;
+    double Time, ShakeEnd;
+    uint64_t TimerSequence;
+    Pcg32 Rng;
+
+    unsigned int PowerUpCount;
+    unsigned int TimerCount;
+    unsigned int BrickWords;
+};
+
+struct SnapshotPowerUp
+{
+    glm::vec2 Position;
+    glm::vec3 Color;
+    unsigned char Type;
+    bool Destroyed, Activated;
+};
+
+struct SnapshotTimer
+{
+    double Deadline;
+    uint64_t Sequence;
+    TimerType Type;
+    // position of the power-up among the saved ones, -1 if it is gone
+    int PowerUp;
+};
+
+size_t Simulation::SnapshotSize() const
+{
+    return sizeof(SnapshotHeader) + PowerUps.Size() * sizeof(SnapshotPowerUp) + Timers.Size() * sizeof(SnapshotTimer)
+        + Levels[Level].DestroyedBits.size() * sizeof(uint64_t);
+}
+
+size_t Simulation::SaveSnapshot(void* buffer) const
+{
+    const std::vector<uint64_t>& bricks = Levels[Level].DestroyedBits;
+
+    // zeroed first, padding included, so equal states give byte-identical snapshots
+    SnapshotHeader header;
+    std::memset(static_cast<void*>(&header), 0, sizeof(header));
+    header.State = State;
+    header.Level = Level;
+    header.BallPosition = Ball.Position;
+    header.BallVelocity = Ball.Velocity;
+    header.BallSize = Ball.Size;
+    header.BallColor = Ball.Color;
+    header.BallRadius = Ball.Radius;
+    header.BallStuck = Ball.Stuck;
+    header.BallSticky = Ball.Sticky;
+    header.BallPassThrough = Ball.PassThrough;
+    header.PaddlePosition = Paddle.Position;
+    header.PaddleSize = Paddle.Size;
+    header.PaddleColor = Paddle.Color;
+    header.Confuse = Confuse;
+    header.Chaos = Chaos;
+    header.Shake = Shake;
+    header.Time = Time;
+    header.ShakeEnd = ShakeEnd;
+    header.TimerSequence = Timers.Sequence;
+    header.Rng = Rng;
+    header.PowerUpCount = PowerUps.Size();
+    header.TimerCount = Timers.Size();
+    header.BrickWords = static_cast<unsigned int>(bricks.size());
+
+    unsigned char* out = static_cast<unsigned char*>(buffer);
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    for (const PowerUp& powerup : PowerUps)
+    {
+        SnapshotPowerUp saved;
+        std::memset(static_cast<void*>(&saved), 0, sizeof(saved));
+        saved.Position = powerup.Position;
+        saved.Color = powerup.Color;
+        saved.Type = static_cast<unsigned char>(powerup.Type);
+        saved.Destroyed = powerup.Destroyed;
+        saved.Activated = powerup.Activated;
+        std::memcpy(out, &saved, sizeof(saved));
+        out += sizeof(saved);
+    }
+    // in heap order, so restoring them one after the other gives back the same heap
+    for (unsigned int i = 0; i < Timers.Size(); ++i)
+    {
+        SnapshotTimer saved;
+        std::memset(static_cast<void*>(&saved), 0, sizeof(saved));
+        saved.Deadline = Timers[i].Deadline;
+        saved.Sequence = Timers[i].Sequence;
+        saved.Type = Timers[i].Type;
+        saved.PowerUp = PowerUps.IndexOf(Timers[i].PowerUp);
+        std::memcpy(out, &saved, sizeof(saved));
+        out += sizeof(saved);
+    }
+    std::memcpy(out, bricks.data(), bricks.size() * sizeof(uint64_t));
+    out += bricks.size() * sizeof(uint64_t);
+    return out - static_cast<unsigned char*>(buffer);
+}
+
+bool Simulation::RestoreSnapshot(const void* buffer, size_t size)
+{
+    SnapshotHeader header;
+    if (size < sizeof(header))
+        return false;
+    const unsigned char* in = static_cast<const unsigned char*>(buffer);
+    std::memcpy(&header, in, sizeof(header));
+    in += sizeof(header);
+    if (static_cast<unsigned int>(header.State) > GAME_WIN
+        || header.Level >= Levels.size() || header.BrickWords != Levels[header.Level].DestroyedBits.size()
+        || header.PowerUpCount > PowerUps.Capacity()
+        || size != sizeof(header) + header.PowerUpCount * sizeof(SnapshotPowerUp) + header.TimerCount * sizeof(SnapshotTimer)
+            + header.BrickWords * sizeof(uint64_t))
+        return false;
+    // enums and indices come back as raw bytes too, nothing is restored unless every one of them is valid
+    for (unsigned int i = 0; i < header.PowerUpCount; ++i)
+    {
+        SnapshotPowerUp saved;
+        std::memcpy(&saved, in + i * sizeof(saved), sizeof(saved));
+        if (saved.Type >= POWERUP_TYPE_COUNT)
+            return false;
+    }
+    const unsigned char* timers = in + header.PowerUpCount * sizeof(SnapshotPowerUp);
+    for (unsigned int i = 0; i < header.TimerCount; ++i)
+    {
+        SnapshotTimer saved;
+        std::memcpy(&saved, timers + i * sizeof(saved), sizeof(saved));
+        if (static_cast<unsigned int>(saved.Type) > TIMER_POWERUP_END
+            || saved.PowerUp < -1 || (saved.PowerUp >= 0 && static_cast<unsigned int>(saved.PowerUp) >= header.PowerUpCount))
+            return false;
+    }
+
+    State = header.State;
+    Level = header.Level;
+    Ball.Position = header.BallPosition;
+    Ball.Velocity = header.BallVelocity;
+    Ball.Size = header.BallSize;
+    Ball.Color = header.BallColor;
+    Ball.Radius = header.BallRadius;
+    Ball.Stuck = header.BallStuck;
+    Ball.Sticky = header.BallSticky;
+    Ball.PassThrough = header.BallPassThrough;
+    Paddle.Position = header.PaddlePosition;
+    Paddle.Size = header.PaddleSize;
+    Paddle.Color = header.PaddleColor;
+    Confuse = header.Confuse;
+    Chaos = header.Chaos;
+    Shake = header.Shake;
+    Time = header.Time;
+    ShakeEnd = header.ShakeEnd;
+    Rng = header.Rng;
+
+    // respawned in their saved order, which is all the simulation depends on
+    PowerUps.Clear();
+    for (unsigned int i = 0; i < header.PowerUpCount; ++i)
+    {
+        SnapshotPowerUp saved;
+        std::memcpy(&saved, in, sizeof(saved));
+        in += sizeof(saved);
+        PowerUp& powerup = *PowerUps.Get(PowerUps.Spawn(static_cast<PowerUpType>(saved.Type), saved.Position));
+        powerup.Color = saved.Color;
+        powerup.Destroyed = saved.Destroyed;
+        powerup.Activated = saved.Activated;
+    }
+    Timers.Clear();
+    Timers.Sequence = header.TimerSequence;
+    for (unsigned int i = 0; i < header.TimerCount; ++i)
+    {
+        SnapshotTimer saved;
+        std::memcpy(&saved, in, sizeof(saved));
+        in += sizeof(saved);
+        Timers.Append({ saved.Deadline, saved.Sequence, saved.Type, saved.PowerUp >= 0 ? PowerUps.HandleAt(saved.PowerUp) : PowerUpHandle() });
+    }
+    std::memcpy(Levels[Level].DestroyedBits.data(), in, header.BrickWords * sizeof(uint64_t));
+    countActivePowerUps();
+    return true;
+}
+
+void Simulation::SaveSnapshot(SimSnapshot& snapshot) const
+{
+    snapshot.Data.resize(SnapshotSize());
+    SaveSnapshot(snapshot.Data.data());
+}
+
+bool Simulation::RestoreSnapshot(const SimSnapshot& snapshot)
+{
+    return RestoreSnapshot(snapshot.Data.data(), snapshot.Data.size());
+}
+
+void MovePaddle(const SimInput& input, float dt, float& paddleX, float paddleWidth, float& ballX, bool ballStuck, unsigned int width)
+{
+    float velocity = PLAYER_VELOCITY * dt;
+    if (input.Left)
+    {
+        if (paddleX >= 0.0f)
+            paddleX -= velocity;
+        if (ballStuck)
+            ballX -= velocity;
+    }
+    if (input.Right)
+    {
+        if (paddleX <= width - paddleWidth)
+            paddleX += velocity;
+        if (ballStuck)
+            ballX += velocity;
+    }
+}
+
+// Power Up
+bool Simulation::shouldSpawn(unsigned int chance)
+{
+    return Rng.NextBounded(chance) == 0;
+}
+
+void Simulation::activatePowerUp(PowerUpHandle handle)
+{
+    PowerUp& powerUp = *PowerUps.Get(handle);
+    const PowerUpDefinition& definition = POWERUP_DEFINITIONS[powerUp.Type];
+    definition.Apply(*this);
+    powerUp.Activated = true;
+    ++ActiveCount[powerUp.Type];
+    Timers.Schedule(Time + definition.Duration, TIMER_POWERUP_END, handle);
+}
+
+void Simulation::countActivePowerUps()
+{
+    std::fill(ActiveCount, ActiveCount + POWERUP_TYPE_COUNT, 0u);
+    for (const PowerUp& powerup : PowerUps)
+    {
+        if (powerup.Activated)
+            ++ActiveCount[powerup.Type];
+    }
+}
+
+void Simulation::fireTimer(const Timer& timer)
+{
+    if (timer.Type == TIMER_SHAKE_END)
+    {
+        // unless a later hit moved the end
+        if (timer.Deadline == ShakeEnd)
+            Shake = false;
+        return;
+    }
+
+    // ResetLevel may have ended it early already
+    PowerUp* powerup = PowerUps.Get(timer.PowerUp);
+    if (!powerup || !powerup->Activated)
+        return;
+    powerup->Activated = false;
+    // the effect only ends with the last active power-up of its type
+    const PowerUpDefinition& definition = POWERUP_DEFINITIONS[powerup->Type];
+    if (--ActiveCount[powerup->Type] == 0 && definition.Expire)
+        definition.Expire(*this);
+    // despawned by resolve once every timer of the step has fired
+    powerup->Destroyed = true;
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include "GameLevel.h"
+#include "TimerQueue.h"
+#include "Player.h"
+#include "BallObject.h"
+#include "Random.h"
+
+enum GameState
+{
+	GAME_ACTIVE,
+	GAME_MENU,
+	GAME_WIN
+};
+
+// player intent for a single step, decoupled from any windowing key codes
+struct SimInput
+{
+	bool Left = false;
+	bool Right = false;
+	bool Launch = false;
+};
+
+// things that happened during a step that the renderer may want to show, e.g. with particles
+enum SimEventType
+{
+	EVENT_BRICK_DESTROYED,
+	EVENT_POWERUP_COLLECTED
+};
+
+struct SimEvent
+{
+	SimEventType Type;
+	// center of the brick or power-up involved
+	glm::vec2 Position;
+	glm::vec3 Color;
+};
+
+// Flat copy of the gameplay state: plain bytes with no pointers, so it can be memcpy'd into an
+// arena and restored later. Reusing one snapshot for many saves does not allocate once it has
+// grown to fit.
+struct SimSnapshot
+{
+	std::vector<unsigned char> Data;
+};
+
+// Headless breakout game state. Holds everything gameplay needs and nothing rendering needs,
+// so it can be stepped without a window or an OpenGL context.
+class Simulation
+{
+public:
+	GameState State;
+	unsigned int Width, Height;
+
+	std::vector<GameLevel> Levels;
+	PowerUpPool PowerUps;
+	// activated power-ups per type whose effect has not run out yet
+	unsigned int ActiveCount[POWERUP_TYPE_COUNT];
+	unsigned int Level;
+
+	Player Paddle;
+	BallObject Ball;
+
+	// gameplay driven effects, the renderer maps these onto its post processor
+	bool Confuse, Chaos, Shake;
+
+	// simulated seconds since the game started, the clock Timers run on
+	double Time;
+	// ends of timed effects (shake, power-ups) still to come
+	TimerQueue Timers;
+	// when the current shake ends; a later hit moves it, which leaves the earlier timer to fire for nothing
+	double ShakeEnd;
+
+	// gameplay randomness (power-up spawns), seeded per game so runs are reproducible
+	Pcg32 Rng;
+
+	// events of the last Update, cleared when the next one starts. Purely cosmetic, so they are
+	// neither hashed nor part of snapshots
+	std::vector<SimEvent> Events;
+
+	Simulation(unsigned int width, unsigned int height, uint64_t seed = 0);
+
+	// restarts the random sequence; games sharing a seed but using different streams are independent
+	void Seed(uint64_t seed, uint64_t stream = 0);
+
+	// loads a level file sized to the top half of the play field and appends it to Levels
+	void LoadLevel(const char* file);
+
+	void ProcessInput(const SimInput& input, float dt);
+	void Update(float dt);
+
+	// ProcessInput followed by Update
+	void Step(const SimInput& input, float dt);
+
+	// fingerprint of the full gameplay state, equal hashes mean two runs ended up identical
+	uint64_t Hash() const;
+
+	// snapshots cover the ball, paddle, power-ups, effects, random state and the bricks of the
+	// current level; the level layouts themselves are not copied
+	size_t SnapshotSize() const;
+	// buffer must hold SnapshotSize() bytes, returns the number of bytes written
+	size_t SaveSnapshot(void* buffer) const;
+	// false (and nothing restored) if the data does not fit this simulation's levels
+	bool RestoreSnapshot(const void* buffer, size_t size);
+
+	void SaveSnapshot(SimSnapshot& snapshot) const;
+	bool RestoreSnapshot(const SimSnapshot& snapshot);
+
+	void DoCollision();
+	void SpawnPowerUps(GameObject& block);
+	void UpdatePowerUps(float dt);
+	void ResetLevel();
+private:
+	friend class SimulationBatch;
+
+	// everything Update does after the ball has moved: collisions, power-ups, effects and loss
+	void resolve(float dt);
+	void collideBrick(GameLevel& level, unsigned int index);
+	bool shouldSpawn(unsigned int chance);
+	void activatePowerUp(PowerUpHandle handle);
+	void countActivePowerUps();
+	void fireTimer(const Timer& timer);
+};
+
+// moves the paddle (and a ball stuck to it) for one step of input.
+// works on plain floats so both Simulation and the batched state arrays share it
+void MovePaddle(const SimInput& input, float dt, float& paddleX, float paddleWidth, float& ballX, bool ballStuck, unsigned int width);
@@ -0,0 +1,96 @@
+#include "simpch.h"
+#include "SimulationBatch.h"
+#include "Profiler.h"
+
+SimulationBatch::SimulationBatch(unsigned int count, unsigned int width, unsigned int height, uint64_t seed, unsigned int threads)
+	: BallX(count), BallY(count), BallVelX(count), BallVelY(count),
+	BallStuck(count), BallSticky(count), BallPassThrough(count),
+	PaddleX(count), PaddleWidth(count),
+	Confuse(count), Chaos(count), Shake(count),
+	games(count, Simulation(width, height)), pool(threads)
+{
+	for (unsigned int i = 0; i < count; ++i)
+	{
+		games[i].Seed(seed, i);
+		scatter(i);
+	}
+}
+
+void SimulationBatch::LoadLevel(const char* file)
+{
+	if (games.empty())
+		return;
+	games[0].LoadLevel(file);
+	for (unsigned int i = 1; i < games.size(); ++i)
+		games[i].Levels.push_back(games[0].Levels.back());
+}
+
+void SimulationBatch::Step(const SimInput* actions, float dt)
+{
+	pool.Run(Size(), [this, actions, dt](unsigned int begin, unsigned int end)
+	{
+		stepRange(actions, dt, begin, end);
+	});
+}
+
+void SimulationBatch::stepRange(const SimInput* actions, float dt, unsigned int begin, unsigned int end)
+{
+	PROFILE_FUNCTION();
+	// input, straight over the arrays
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (games[i].State != GAME_ACTIVE)
+			continue;
+		MovePaddle(actions[i], dt, PaddleX[i], PaddleWidth[i], BallX[i], BallStuck[i] != 0, games[i].Width);
+		if (actions[i].Launch)
+			BallStuck[i] = false;
+	}
+
+	// ball integration, straight over the arrays
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		if (BallStuck[i])
+			continue;
+		MoveBall(BallX[i], BallY[i], BallVelX[i], BallVelY[i], games[i].Ball.Size.x, dt, static_cast<float>(games[i].Width));
+	}
+
+	// collisions and game rules need the per game bricks and power-ups
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		gather(i);
+		games[i].resolve(dt);
+		scatter(i);
+	}
+}
+
+void SimulationBatch::gather(unsigned int index)
+{
+	Simulation& game = games[index];
+	game.Ball.Position = glm::vec2(BallX[index], BallY[index]);
+	game.Ball.Velocity = glm::vec2(BallVelX[index], BallVelY[index]);
+	game.Ball.Stuck = BallStuck[index] != 0;
+	game.Ball.Sticky = BallSticky[index] != 0;
+	game.Ball.PassThrough = BallPassThrough[index] != 0;
+	game.Paddle.Position.x = PaddleX[index];
+	game.Paddle.Size.x = PaddleWidth[index];
+	game.Confuse = Confuse[index] != 0;
+	game.Chaos = Chaos[index] != 0;
+	game.Shake = Shake[index] != 0;
+}
+
+void SimulationBatch::scatter(unsigned int index)
+{
+	const Simulation& game = games[index];
+	BallX[index] = game.Ball.Position.x;
+	BallY[index] = game.Ball.Position.y;
+	BallVelX[index] = game.Ball.Velocity.x;
+	BallVelY[index] = game.Ball.Velocity.y;
+	BallStuck[index] = game.Ball.Stuck;
+	BallSticky[index] = game.Ball.Sticky;
+	BallPassThrough[index] = game.Ball.PassThrough;
+	PaddleX[index] = game.Paddle.Position.x;
+	PaddleWidth[index] = game.Paddle.Size.x;
+	Confuse[index] = game.Confuse;
+	Chaos[index] = game.Chaos;
+	Shake[index] = game.Shake;
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Simulation.h"
+#include "WorkerPool.h"
+
+// Steps N independent games with a single call.
+// The per-step hot state (ball, paddle and power-up effects) of all games is kept as
+// structure of arrays so the movement kernels stream through contiguous memory and
+// observations can be read straight out of the arrays. Bricks and falling power-ups stay
+// inside one Simulation per game since their counts differ between games.
+class SimulationBatch
+{
+public:
+	// ball
+	std::vector<float> BallX, BallY, BallVelX, BallVelY;
+	std::vector<unsigned char> BallStuck, BallSticky, BallPassThrough;
+
+	// paddle
+	std::vector<float> PaddleX, PaddleWidth;
+
+	// power-up effects; when they end is up to each game's Timers
+	std::vector<unsigned char> Confuse, Chaos, Shake;
+
+	// threads = 0 uses one thread per hardware core. Game i draws from random stream i of seed,
+	// so results do not depend on the number of threads
+	SimulationBatch(unsigned int count, unsigned int width, unsigned int height, uint64_t seed = 0, unsigned int threads = 0);
+
+	inline unsigned int Size() const { return static_cast<unsigned int>(games.size()); }
+	inline unsigned int Threads() const { return pool.Threads(); }
+
+	// loads a level file into every game
+	void LoadLevel(const char* file);
+
+	// advances game i by actions[i] for every game
+	void Step(const SimInput* actions, float dt);
+
+	// cold per game state (bricks, falling power-ups); the hot fields in it are only
+	// current after Step has returned
+	inline const Simulation& GetGame(unsigned int index) const { return games[index]; }
+private:
+	std::vector<Simulation> games;
+	WorkerPool pool;
+
+	void stepRange(const SimInput* actions, float dt, unsigned int begin, unsigned int end);
+	void gather(unsigned int index);
+	void scatter(unsigned int index);
+};
@@ -0,0 +1,38 @@
+#include "simpch.h"
+#include "TimerQueue.h"
+
+// std heaps keep the largest element on top, so "less" means "fires later"
+static bool firesLater(const Timer& a, const Timer& b)
+{
+	if (a.Deadline != b.Deadline)
+		return a.Deadline > b.Deadline;
+	return a.Sequence > b.Sequence;
+}
+
+TimerQueue::TimerQueue()
+	:Sequence(0)
+{
+	heap.reserve(64);
+}
+
+void TimerQueue::Schedule(double deadline, TimerType type, PowerUpHandle powerUp)
+{
+	heap.push_back({ deadline, Sequence++, type, powerUp });
+	std::push_heap(heap.begin(), heap.end(), firesLater);
+}
+
+bool TimerQueue::PopExpired(double now, Timer& timer)
+{
+	if (heap.empty() || heap.front().Deadline > now)
+		return false;
+	std::pop_heap(heap.begin(), heap.end(), firesLater);
+	timer = heap.back();
+	heap.pop_back();
+	return true;
+}
+
+void TimerQueue::Clear()
+{
+	heap.clear();
+	Sequence = 0;
+}
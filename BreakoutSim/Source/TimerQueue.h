@@ -0,0 +1,43 @@
+#pragma once
+#include "PowerUpPool.h"
+
+// what happens when a timer fires
+enum TimerType
+{
+	TIMER_SHAKE_END,
+	TIMER_POWERUP_END
+};
+
+struct Timer
+{
+	// simulation time the timer fires at
+	double Deadline;
+	// order it was scheduled in, breaks ties between equal deadlines
+	uint64_t Sequence;
+	TimerType Type;
+	// whose effect ends, TIMER_POWERUP_END only
+	PowerUpHandle PowerUp;
+};
+
+// Pending timers as a min-heap on deadline. Scheduling and firing are O(log n), so a step only
+// pays for the timers that are due, not for every object that is timed.
+class TimerQueue
+{
+public:
+	// sequence number the next scheduled timer gets
+	uint64_t Sequence;
+
+	TimerQueue();
+
+	void Schedule(double deadline, TimerType type, PowerUpHandle powerUp = PowerUpHandle());
+	// removes the earliest timer that is due at now, false if none is
+	bool PopExpired(double now, Timer& timer);
+	void Clear();
+
+	inline unsigned int Size() const { return static_cast<unsigned int>(heap.size()); }
+	// the pending timers in heap order; appending them back in that order restores the queue
+	inline const Timer& operator[](unsigned int i) const { return heap[i]; }
+	inline void Append(const Timer& timer) { heap.push_back(timer); }
+private:
+	std::vector<Timer> heap;
+};
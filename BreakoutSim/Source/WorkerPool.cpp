@@ -0,0 +1,78 @@
+#include "simpch.h"
+#include "WorkerPool.h"
+
+WorkerPool::WorkerPool(unsigned int threads)
+	: job(nullptr), count(0), generation(0), pending(0), stopping(false)
+{
+	if (threads == 0)
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	// index 0 is the calling thread
+	for (unsigned int i = 1; i < threads; ++i)
+		workers.emplace_back(&WorkerPool::workerLoop, this, i);
+}
+
+WorkerPool::~WorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+void WorkerPool::Run(unsigned int count, const Job& job)
+{
+	if (workers.empty() || count < 2)
+	{
+		job(0, count);
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->job = &job;
+		this->count = count;
+		pending = static_cast<unsigned int>(workers.size());
+		++generation;
+	}
+	wake.notify_all();
+
+	runRange(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	finished.wait(lock, [this] { return pending == 0; });
+	this->job = nullptr;
+}
+
+void WorkerPool::workerLoop(unsigned int index)
+{
+	unsigned int seen = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+			if (stopping)
+				return;
+			seen = generation;
+		}
+
+		runRange(index);
+
+		// notify under the lock so Run cannot return and destroy the pool in between
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--pending == 0)
+			finished.notify_one();
+	}
+}
+
+void WorkerPool::runRange(unsigned int index)
+{
+	// contiguous static partition, every game costs about the same to step
+	unsigned int threads = Threads();
+	unsigned int begin = static_cast<unsigned int>(static_cast<unsigned long long>(count) * index / threads);
+	unsigned int end = static_cast<unsigned int>(static_cast<unsigned long long>(count) * (index + 1) / threads);
+	if (begin < end)
+		(*job)(begin, end);
+}
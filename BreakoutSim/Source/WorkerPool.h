@@ -0,0 +1,38 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Fixed set of persistent threads that split an index range between them.
+// The calling thread takes part in the work, so a pool of one thread spawns nothing.
+class WorkerPool
+{
+public:
+	typedef std::function<void(unsigned int begin, unsigned int end)> Job;
+
+	// threads = 0 uses one thread per hardware core
+	explicit WorkerPool(unsigned int threads = 0);
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	inline unsigned int Threads() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+	// splits [0, count) into one contiguous range per thread and blocks until every range is done
+	void Run(unsigned int count, const Job& job);
+private:
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable wake, finished;
+	const Job* job;
+	unsigned int count;
+	unsigned int generation;
+	unsigned int pending;
+	bool stopping;
+
+	void workerLoop(unsigned int index);
+	void runRange(unsigned int index);
+};
@@ -0,0 +1 @@
+#include "simpch.h"
@@ -0,0 +1,19 @@
+#pragma once
+
+// General
+#include <iostream>
+#include <memory>
+#include <algorithm>
+#include <string>
+#include <sstream>
+#include <vector>
+#include <fstream>
+#include <tuple>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+
+// GLM
+#include <glm/glm.hpp>
+
+// note: BreakoutSim must stay free of any OpenGL/GLFW includes so it can run headless
@@ -1,10 +1,168 @@
+newoption
+{
+	trigger = "profile",
+	description = "Compile the PROFILE_ scope timers in (see Profiler.h)"
+}
+
+newoption
+{
+	trigger = "avx",
+	description = "Build for CPUs with AVX, enables the wider particle update kernel"
+}
+
 workspace "Breakout2.0"
 	architecture "x64"
 	configurations {"Debug", "Release"}
+	startproject "Breakout2.0"
+
+	filter "options:profile"
+		defines { "BREAKOUT_PROFILE" }
+	filter "options:avx"
+		vectorextensions "AVX"
+	filter {}
 
 outputdir = "%{cfg.buildcfg}-${cfg.system}-%{cfg.architecture}"
 
 includeDir = "Libraries/include"
+simIncludeDir = "BreakoutSim/Source"
+
+-- headless gameplay library, must not depend on OpenGL or GLFW
+project "BreakoutSim"
+	location "BreakoutSim"
+	kind "StaticLib"
+	language "C++"
+	cppdialect "C++17"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	pchheader "simpch.h"
+	pchsource "BreakoutSim/Source/simpch.cpp"
+	files
+	{
+		"%{prj.name}/Source/**.h",
+		"%{prj.name}/Source/**.cpp",
+	}
+
+	includedirs
+	{
+		includeDir,
+		simIncludeDir
+	}
+
+	filter "system:windows"
+		staticruntime "On"
+		systemversion "latest"
+		-- runtime has to match Breakout2.0 which it is linked into
+		buildoptions "/MDd"
+
+	filter "system:linux"
+		pic "On"
+
+	filter "configurations:Debug"
+		symbols "On"
+
+	filter "configurations:Release"
+		optimize "On"
+
+-- replays recorded games without a window, as fast as the CPU allows
+project "BreakoutHeadless"
+	location "BreakoutHeadless"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/Source/**.h",
+		"%{prj.name}/Source/**.cpp",
+	}
+
+	includedirs
+	{
+		includeDir,
+		simIncludeDir
+	}
+	links
+	{
+		"BreakoutSim"
+	}
+
+	filter "system:windows"
+		staticruntime "On"
+		systemversion "latest"
+		buildoptions "/MDd"
+
+	filter "system:linux"
+		links { "pthread" }
+
+	filter "configurations:Debug"
+		symbols "On"
+
+	filter "configurations:Release"
+		optimize "On"
+
+-- microbenchmarks for the hot paths, run from its own directory or pass --root
+project "Benchmarks"
+	location "Benchmarks"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	targetdir ("bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("bin-int/" .. outputdir .. "/%{prj.name}")
+
+	files
+	{
+		"%{prj.name}/Source/**.h",
+		"%{prj.name}/Source/**.cpp",
+		-- renderer side code under test
+		"Breakout2.0/Source/Breakout/ParticleSystem/ParticleGenerator.cpp",
+		"Breakout2.0/Source/Breakout/ParticleSystem/ParticleSystem.cpp",
+		"Breakout2.0/Source/Breakout/BrickRenderer.cpp",
+		"Breakout2.0/Source/Breakout/FrameData.cpp",
+		"Breakout2.0/Source/Breakout/GLState.cpp",
+		"Breakout2.0/Source/Breakout/PostProcessing/Bloom.cpp",
+		"Breakout2.0/Source/Breakout/PostProcessing/EffectChain.cpp",
+		"Breakout2.0/Source/Breakout/PostProcessing/RenderTargetPool.cpp",
+		"Breakout2.0/Source/Breakout/ResourceManager.cpp",
+		"Breakout2.0/Source/Breakout/Shader.cpp",
+		"Breakout2.0/Source/Breakout/SpriteBatch.cpp",
+		"Breakout2.0/Source/Breakout/SpriteRenderer.cpp",
+		"Breakout2.0/Source/Breakout/Texture.cpp"
+	}
+
+	includedirs
+	{
+		includeDir,
+		"breakout2.0/source",
+		"breakout2.0/Source/Breakout",
+		simIncludeDir
+	}
+	libdirs
+	{
+		"Libraries/lib"
+	}
+	links
+	{
+		"BreakoutSim",
+		"glfw3.lib",
+		"opengl32.lib"
+	}
+
+	filter "system:windows"
+		staticruntime "On"
+		systemversion "latest"
+		buildoptions "/MDd"
+
+	filter "configurations:Debug"
+		symbols "On"
+
+	filter "configurations:Release"
+		optimize "On"
 
 project "Breakout2.0"
 	location "Breakout2.0"
@@ -26,7 +184,8 @@ project "Breakout2.0"
 	{
 		includeDir,
 		"breakout2.0/source",
-		"breakout2.0/Source/Breakout"
+		"breakout2.0/Source/Breakout",
+		simIncludeDir
 	}
 	libdirs
 	{
@@ -34,6 +193,7 @@ project "Breakout2.0"
 	}
 	links
 	{
+		"BreakoutSim",
 		"glfw3.lib",
 		"opengl32.lib"
 	}